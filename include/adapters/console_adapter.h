@@ -8,7 +8,10 @@
 #include <memory>
 
 #include "../core/console.h"
+#include "../backend/distance_cache.h"
+#include "../backend/dynamic_distances.h"
 #include "../backend/graph_gen.h"
+#include "../backend/jobs.h"
 
 class GraphConsoleAdapter {
     public:
@@ -17,27 +20,56 @@ class GraphConsoleAdapter {
 
     void run();
 
+    /**
+     * Run commands non-interactively (no prompts, colours or exit pause)
+     * @param input Command lines, one per line
+     * @return Number of commands that failed
+     */
+    int run_batch(std::istream& input);
+
     private:
     Console console;
 
     bool graphs_created;
-    std::unique_ptr<Graph> graph;
+    std::shared_ptr<Graph> graph;
     int n;
+    // Distances of the BFS traversals run on the current graph, repaired on every edge change
+    DynamicDistances distances;
+    // BFS results of traversal and compare runs by graph version; background jobs store into it
+    DistanceCache cache;
+
+    // Declared last so running jobs are cancelled and joined before anything else is torn down
+    JobManager jobs;
 
     void cleanup();
+    // Replace the current graph
+    void adopt_graph(std::shared_ptr<Graph> created);
     void register_graph_commands();
     std::string find_config_file(const std::string& filename, const std::vector<std::string>& search_paths);
     std::string get_default_config_path();
 
-    void cmd_create(const std::vector<std::string>& args);
+    void cmd_create(const std::vector<std::string>& arguments);
     void cmd_print() const;
     void cmd_clear();
     void cmd_cleanup();
     void cmd_exit();
     void cmd_help(const std::vector<std::string>& args);
     void cmd_history();
-    void cmd_traversal(const std::vector<std::string>& args) const;
-    void cmd_compare(const std::vector<std::string>& args) const;
+    void cmd_traversal(const std::vector<std::string>& args);
+    void cmd_dijkstra(const std::vector<std::string>& arguments) const;
+    void cmd_compare(const std::vector<std::string>& arguments);
+    void cmd_bench(const std::vector<std::string>& arguments);
+    void cmd_save(const std::vector<std::string>& args) const;
+    void cmd_load(const std::vector<std::string>& arguments);
+    void cmd_import(const std::vector<std::string>& args);
+    void cmd_distance(const std::vector<std::string>& args) const;
+    void cmd_reorder(const std::vector<std::string>& args);
+    void cmd_edit_edge(const std::vector<std::string>& args, bool add);
+    void cmd_cache(const std::vector<std::string>& args);
+    void cmd_stats() const;
+    void cmd_jobs() const;
+    void cmd_wait(const std::vector<std::string>& args);
+    void cmd_cancel(const std::vector<std::string>& args);
 
     static void cmd_smile();
 };
@@ -0,0 +1,36 @@
+#ifndef ALL_PAIRS_H
+#define ALL_PAIRS_H
+
+#include "distance_matrix.h"
+#include "graph_gen.h"
+#include "jobs.h"
+#include "parallel.h"
+
+/**
+ * Run a search kernel from every vertex, splitting the sources across a pool of worker threads.
+ * Each thread owns one reusable workspace and writes only the reached vertices into its rows of the matrix.
+ * @param graph Currently being examined graph
+ * @param kernel Search kernel to run from each source
+ * @param threads Number of worker threads (0 - all hardware threads)
+ * @param dist_matrix Matrix reset to n vertices (all pairs unreachable); row i receives the distances from vertex i
+ * @param job Optional job to report finished sources to; remaining sources are skipped once it is cancelled
+ * @return Counters of all searches merged over the worker threads
+ */
+extern TraversalStats all_pairs_distances(const Graph& graph, SearchKernel kernel, int threads, DistanceMatrix& dist_matrix,
+                                          JobControl* job = nullptr);
+
+/**
+ * Bit-parallel multi-source BFS (MS-BFS): runs msbfs_batch_size() sources through one shared traversal,
+ * keeping per-vertex seen/visit bitsets with one bit per source, so each adjacency row is read
+ * once per batch instead of once per source. Batches are split across a pool of worker threads.
+ * @param graph Currently being examined graph
+ * @param threads Number of worker threads (0 - all hardware threads)
+ * @param dist_matrix Matrix reset to n vertices (all pairs unreachable); row i receives the distances from vertex i
+ * @param job Optional job to report finished sources to; remaining batches are skipped once it is cancelled
+ */
+extern void all_pairs_msbfs(const Graph& graph, int threads, DistanceMatrix& dist_matrix, JobControl* job = nullptr);
+
+// Sources per MS-BFS batch, chosen once at startup: 256 on CPUs with AVX2, 64 otherwise
+extern int msbfs_batch_size();
+
+#endif //ALL_PAIRS_H
@@ -0,0 +1,68 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "graph_gen.h"
+
+// Benchmark grid and run settings
+struct BenchOptions {
+    std::vector<int> sizes = {500, 2000};
+    std::vector<double> edge_probs = {0.01, 0.1, 0.4};
+    std::vector<Representation> representations = {Representation::Matrix, Representation::List, Representation::CSR};
+    std::vector<Method> methods = {Method::BFS, Method::DFS, Method::DOBFS};
+    double loop_prob = 0.15;
+    unsigned int seed = 1;
+    int warmup = 2;
+    int repetitions = 10;
+    bool use_current = false;   // benchmark the given graph instead of generating the grid
+    std::string csv_path;       // "-" writes to stdout
+    std::string json_path;      // "-" writes to stdout
+};
+
+// Timing summary of one grid cell
+struct BenchResult {
+    int n;
+    double edge_prob;
+    Representation representation;
+    Method method;
+    int repetitions;
+    double min_us;
+    double median_us;
+    double p99_us;
+    double edges_per_second;
+    double bytes_per_vertex;
+    long long edges_traversed;
+};
+
+/**
+ * Parse bench arguments:
+ *      --n 500,2000  --p 0.01,0.4  --rep m,l,csr  --method bfs,dfs,dobfs  --loop 0.15
+ *      --seed S  --warmup W  --reps R  --current  --csv <file|->  --json <file|->
+ * @throws std::invalid_argument on an unknown option or bad value
+ */
+extern BenchOptions parse_bench_options(const std::vector<std::string>& args);
+
+/**
+ * Run warm-up plus timed repetitions for every (n, edgeProb, representation, method) cell.
+ * Each repetition times only the no-output search kernel from a rotating source vertex.
+ * @param options Grid and run settings
+ * @param current Graph used when options.use_current is set
+ * @param job Optional job to report finished searches to; throws JobCancelled once it is cancelled
+ * @return One result per cell that applies to the graph
+ */
+extern std::vector<BenchResult> run_bench(const BenchOptions& options, const Graph* current = nullptr, JobControl* job = nullptr);
+
+// Human-readable table
+extern void print_bench_table(const std::vector<BenchResult>& results, std::ostream& out);
+
+// Machine-readable reports for regression tracking
+extern void write_bench_csv(const std::vector<BenchResult>& results, std::ostream& out);
+extern void write_bench_json(const std::vector<BenchResult>& results, const BenchOptions& options, std::ostream& out);
+
+// Print the table to console and write the CSV/JSON files requested in options ("-" also goes to console)
+extern void report_bench(const std::vector<BenchResult>& results, const BenchOptions& options, std::ostream& console = std::cout);
+
+#endif //BENCH_H
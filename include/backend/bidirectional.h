@@ -0,0 +1,44 @@
+#ifndef BIDIRECTIONAL_H
+#define BIDIRECTIONAL_H
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+
+#include "graph_gen.h"
+
+// One workspace per search direction, reused across queries
+struct BidirectionalWorkspace {
+    TraversalWorkspace forward;
+    TraversalWorkspace backward;
+
+    // Vertices reached by the last query from both ends
+    [[nodiscard]] std::size_t visited() const {
+        return forward.touched_vertices().size() + backward.touched_vertices().size();
+    }
+};
+
+/**
+ * Point-to-point distance by bidirectional BFS over the CSR arrays.
+ * Searches grow from both ends, always expanding the smaller frontier by one whole level,
+ * and stop after the level in which they first meet.
+ * @param source Start vertex
+ * @param target End vertex
+ * @param graph Currently being examined graph
+ * @param workspace Workspaces for both directions (sized on demand)
+ * @return Distance, -1 if the vertices are not connected
+ */
+extern int bidirectional_distance(int source, int target, const Graph& graph, BidirectionalWorkspace& workspace);
+
+/**
+ * Answer a batch of distance queries, one "u v" pair per line in original vertex ids
+ * (blank lines and lines starting with '#' are skipped). Prints "u v distance" per pair and a summary.
+ * @param graph Currently being examined graph
+ * @param pairs Query lines
+ * @param output Stream the answers are written to
+ * @return Number of answered queries
+ * @throws std::runtime_error on a malformed line or a vertex out of range
+ */
+extern long long distance_batch(const Graph& graph, std::istream& pairs, std::ostream& output);
+
+#endif //BIDIRECTIONAL_H
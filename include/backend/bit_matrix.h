@@ -0,0 +1,100 @@
+#ifndef BIT_MATRIX_H
+#define BIT_MATRIX_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Square bit-packed matrix stored in one contiguous 64-byte aligned block.
+ * Each row is padded to a whole cache line, so rows never share a line and
+ * a row can be scanned 64 columns per load. Padding bits are always zero.
+ * The block is either owned or a view into external memory (e.g. a mapped graph file).
+ */
+class BitMatrix {
+public:
+    using word_type = std::uint64_t;
+    static constexpr int word_bits = 64;
+    static constexpr std::size_t alignment = 64;
+
+    BitMatrix() = default;
+    explicit BitMatrix(int vertices);
+    ~BitMatrix();
+
+    BitMatrix(const BitMatrix&) = delete;
+    BitMatrix& operator=(const BitMatrix&) = delete;
+    BitMatrix(BitMatrix&& other) noexcept;
+    BitMatrix& operator=(BitMatrix&& other) noexcept;
+
+    // Reallocate as a zeroed vertices x vertices matrix (0 frees the storage)
+    void reset(int vertices = 0);
+
+    /**
+     * Non-owning view of rows laid out like an owned matrix (stride words per row, 64-byte aligned)
+     * @param words First word of row 0
+     * @param vertices Matrix size
+     * @param row_stride Words per row
+     * @param keep_alive Handle that keeps the memory alive for the lifetime of the view
+     */
+    static BitMatrix view(word_type* words, int vertices, std::size_t row_stride, std::shared_ptr<const void> keep_alive);
+
+    // Stride in words a matrix of the given size uses
+    static std::size_t stride_for(int vertices);
+
+    [[nodiscard]] int size() const { return n; }
+    [[nodiscard]] bool empty() const { return data == nullptr; }
+    [[nodiscard]] bool is_view() const { return backing != nullptr; }
+    [[nodiscard]] std::size_t words_per_row() const { return stride; }
+    [[nodiscard]] std::size_t bytes() const { return static_cast<std::size_t>(n) * stride * sizeof(word_type); }
+
+    [[nodiscard]] bool test(const int i, const int j) const {
+        return (row(i)[j / word_bits] >> (j % word_bits)) & 1u;
+    }
+    void set(const int i, const int j) { row(i)[j / word_bits] |= word_type{1} << (j % word_bits); }
+    void clear(const int i, const int j) { row(i)[j / word_bits] &= ~(word_type{1} << (j % word_bits)); }
+
+    // Number of set columns in row i
+    [[nodiscard]] std::size_t row_count(const int i) const {
+        std::size_t count = 0;
+        for (std::size_t w = 0; w < stride; w++) count += static_cast<std::size_t>(std::popcount(row(i)[w]));
+        return count;
+    }
+
+    [[nodiscard]] const word_type* row(const int i) const { return data + static_cast<std::size_t>(i) * stride; }
+    [[nodiscard]] word_type* row(const int i) { return data + static_cast<std::size_t>(i) * stride; }
+
+    // Call f(j) for every set column of row i in ascending order
+    template <class F>
+    void for_each_in_row(const int i, F&& f) const {
+        const word_type* r = row(i);
+        for (std::size_t w = 0; w < stride; w++) {
+            for (word_type bits = r[w]; bits != 0; bits &= bits - 1) {
+                f(static_cast<int>(w * word_bits) + std::countr_zero(bits));
+            }
+        }
+    }
+
+    // Call f(j) for every set column of row i in descending order
+    template <class F>
+    void for_each_in_row_reverse(const int i, F&& f) const {
+        const word_type* r = row(i);
+        for (std::size_t w = stride; w-- > 0;) {
+            for (word_type bits = r[w]; bits != 0;) {
+                const int bit = word_bits - 1 - std::countl_zero(bits);
+                bits &= ~(word_type{1} << bit);
+                f(static_cast<int>(w * word_bits) + bit);
+            }
+        }
+    }
+
+private:
+    word_type* data = nullptr;
+    int n = 0;
+    std::size_t stride = 0;
+    std::shared_ptr<const void> backing;
+
+    void release();
+};
+
+#endif //BIT_MATRIX_H
@@ -0,0 +1,91 @@
+#ifndef COROUTINE_GENERATOR_H
+#define COROUTINE_GENERATOR_H
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+/**
+ * Minimal pull-based coroutine generator (C++20 has no std::generator).
+ * The body runs only while the range is advanced, so a consumer that stops iterating
+ * stops the producer too; destroying the generator frees the suspended frame.
+ * Yielded values are referenced in place and stay valid until the next increment.
+ */
+template <class T>
+class Generator {
+public:
+    struct promise_type {
+        const T* current = nullptr;
+        std::exception_ptr exception;
+
+        Generator get_return_object() { return Generator(handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const T& value) noexcept {
+            current = std::addressof(value);
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { exception = std::current_exception(); }
+    };
+    using handle = std::coroutine_handle<promise_type>;
+
+    class iterator {
+    public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(const handle frame) : coroutine(frame) {}
+
+        const T& operator*() const { return *coroutine.promise().current; }
+        const T* operator->() const { return coroutine.promise().current; }
+        iterator& operator++() {
+            resume(coroutine);
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(std::default_sentinel_t) const { return !coroutine || coroutine.done(); }
+
+    private:
+        handle coroutine = nullptr;
+    };
+
+    Generator(Generator&& other) noexcept : coroutine(std::exchange(other.coroutine, nullptr)) {}
+    Generator& operator=(Generator&& other) noexcept {
+        if (this != &other) {
+            if (coroutine) coroutine.destroy();
+            coroutine = std::exchange(other.coroutine, nullptr);
+        }
+        return *this;
+    }
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+    ~Generator() {
+        if (coroutine) coroutine.destroy();
+    }
+
+    // Runs the body up to the first value; call once
+    iterator begin() {
+        resume(coroutine);
+        return iterator(coroutine);
+    }
+    std::default_sentinel_t end() const { return {}; }
+
+private:
+    explicit Generator(const handle frame) : coroutine(frame) {}
+
+    // Exceptions thrown by the body surface where the consumer advances
+    static void resume(const handle frame) {
+        frame.resume();
+        if (frame.promise().exception) std::rethrow_exception(frame.promise().exception);
+    }
+
+    handle coroutine = nullptr;
+};
+
+#endif //COROUTINE_GENERATOR_H
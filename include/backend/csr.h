@@ -0,0 +1,131 @@
+#ifndef CSR_H
+#define CSR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+ * Compressed sparse row adjacency: the neighbours of vertex v are
+ * neighbours[offsets[v] .. offsets[v + 1]), all stored in one array.
+ * The arrays are either owned or a view into external memory (e.g. a mapped graph file)
+ * kept alive by a shared handle.
+ */
+class CSRAdjacency {
+public:
+    CSRAdjacency() = default;
+
+    CSRAdjacency(std::vector<std::int64_t> offset_array, std::vector<int> neighbour_array)
+        : owned_offsets(std::move(offset_array)), owned_neighbours(std::move(neighbour_array)) {
+        point_to_owned();
+    }
+
+    // Non-owning view; keep_alive holds the memory for the lifetime of the adjacency
+    static CSRAdjacency view(const std::span<const std::int64_t> offset_array, const std::span<const int> neighbour_array,
+                             std::shared_ptr<const void> keep_alive) {
+        CSRAdjacency csr;
+        csr.offsets_data = offset_array.data();
+        csr.neighbours_data = neighbour_array.data();
+        csr.offsets_count = offset_array.size();
+        csr.neighbours_count = neighbour_array.size();
+        csr.backing = std::move(keep_alive);
+        return csr;
+    }
+
+    CSRAdjacency(const CSRAdjacency&) = delete;
+    CSRAdjacency& operator=(const CSRAdjacency&) = delete;
+
+    CSRAdjacency(CSRAdjacency&& other) noexcept { *this = std::move(other); }
+
+    CSRAdjacency& operator=(CSRAdjacency&& other) noexcept {
+        if (this != &other) {
+            owned_offsets = std::move(other.owned_offsets);
+            owned_neighbours = std::move(other.owned_neighbours);
+            backing = std::move(other.backing);
+            offsets_data = std::exchange(other.offsets_data, nullptr);
+            neighbours_data = std::exchange(other.neighbours_data, nullptr);
+            offsets_count = std::exchange(other.offsets_count, 0);
+            neighbours_count = std::exchange(other.neighbours_count, 0);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] int size() const { return offsets_count == 0 ? 0 : static_cast<int>(offsets_count) - 1; }
+    [[nodiscard]] bool empty() const { return offsets_count == 0; }
+    [[nodiscard]] bool is_view() const { return backing != nullptr; }
+
+    [[nodiscard]] std::span<const std::int64_t> offsets() const { return {offsets_data, offsets_count}; }
+    [[nodiscard]] std::span<const int> neighbours() const { return {neighbours_data, neighbours_count}; }
+
+    [[nodiscard]] int degree(const int v) const {
+        return static_cast<int>(offsets_data[v + 1] - offsets_data[v]);
+    }
+
+    [[nodiscard]] std::span<const int> row(const int v) const {
+        return {neighbours_data + offsets_data[v], static_cast<std::size_t>(offsets_data[v + 1] - offsets_data[v])};
+    }
+
+    // Add u to the sorted row of v; a view is first copied into owned arrays. O(n + m)
+    void insert(const int v, const int u) {
+        make_owned();
+        const auto first = owned_neighbours.begin() + owned_offsets[v];
+        const auto last = owned_neighbours.begin() + owned_offsets[v + 1];
+        owned_neighbours.insert(std::lower_bound(first, last, u), u);
+        for (std::size_t i = static_cast<std::size_t>(v) + 1; i < owned_offsets.size(); i++) {
+            owned_offsets[i]++;
+        }
+        point_to_owned();
+    }
+
+    // Remove u from the sorted row of v; false if it is not there. O(n + m)
+    bool erase(const int v, const int u) {
+        const auto current = row(v);
+        const auto found = std::lower_bound(current.begin(), current.end(), u);
+        if (found == current.end() || *found != u) return false;
+        const auto position = offsets_data[v] + (found - current.begin());
+
+        make_owned();
+        owned_neighbours.erase(owned_neighbours.begin() + position);
+        for (std::size_t i = static_cast<std::size_t>(v) + 1; i < owned_offsets.size(); i++) {
+            owned_offsets[i]--;
+        }
+        point_to_owned();
+        return true;
+    }
+
+    [[nodiscard]] std::size_t bytes() const {
+        return offsets_count * sizeof(std::int64_t) + neighbours_count * sizeof(int);
+    }
+
+private:
+    std::vector<std::int64_t> owned_offsets;
+    std::vector<int> owned_neighbours;
+    std::shared_ptr<const void> backing;
+
+    const std::int64_t* offsets_data = nullptr;
+    const int* neighbours_data = nullptr;
+    std::size_t offsets_count = 0;
+    std::size_t neighbours_count = 0;
+
+    // Copy viewed arrays into owned storage so they can be edited
+    void make_owned() {
+        if (backing == nullptr) return;
+        owned_offsets.assign(offsets_data, offsets_data + offsets_count);
+        owned_neighbours.assign(neighbours_data, neighbours_data + neighbours_count);
+        backing.reset();
+        point_to_owned();
+    }
+
+    void point_to_owned() {
+        offsets_data = owned_offsets.data();
+        neighbours_data = owned_neighbours.data();
+        offsets_count = owned_offsets.size();
+        neighbours_count = owned_neighbours.size();
+    }
+};
+
+#endif //CSR_H
@@ -0,0 +1,88 @@
+#ifndef DISTANCE_CACHE_H
+#define DISTANCE_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "distance_matrix.h"
+
+/**
+ * Memory-budgeted LRU cache of BFS distance results, keyed by graph version and source vertex.
+ * Holds single-source distance vectors and all-pairs matrices;
+ * a row of a cached all-pairs matrix answers a single-source lookup too (decoded on the hit).
+ * Results are shared, so one being read stays valid even if it is evicted meanwhile.
+ * Thread-safe: background jobs store their results directly.
+ */
+class DistanceCache {
+public:
+    static constexpr std::size_t DEFAULT_BUDGET = std::size_t{256} << 20;
+
+    using Result = std::shared_ptr<const std::vector<int>>;
+
+    // Cached distances from one source; empty on a miss
+    struct Lookup {
+        Result owner;
+        std::span<const int> distances;
+
+        explicit operator bool() const { return owner != nullptr; }
+    };
+
+    explicit DistanceCache(std::size_t budget_bytes = DEFAULT_BUDGET) : budget(budget_bytes) {}
+
+    // Distances from source on the given graph version, counted as a hit or a miss
+    Lookup find(std::uint64_t version, int source);
+
+    /**
+     * Store the distances from one source, evicting the least recently used results to stay within
+     * the budget (a result larger than the whole budget is not stored)
+     * @param version Graph version the result was computed on
+     */
+    void store(std::uint64_t version, int source, std::vector<int> distances);
+
+    // Store an all-pairs matrix (row i holds the distances from vertex i)
+    void store_all_pairs(std::uint64_t version, DistanceMatrix matrix);
+
+    // Drop the results of every other graph version
+    void retain_only(std::uint64_t version);
+
+    void set_budget(std::size_t budget_bytes);
+    void clear();
+
+    // Print entries, resident bytes, budget and hit rate
+    void print(std::ostream& out) const;
+
+private:
+    using Key = std::pair<std::uint64_t, int>;
+
+    // Holds either a single-source result or an all-pairs matrix
+    struct Entry {
+        Key key;
+        Result distances;
+        std::shared_ptr<const DistanceMatrix> matrix;
+        std::size_t bytes = 0;
+    };
+
+    mutable std::mutex mutex;
+    std::list<Entry> entries; // most recently used first
+    std::map<Key, std::list<Entry>::iterator> index;
+    std::size_t budget;
+    std::size_t resident = 0;
+    long long hits = 0;
+    long long misses = 0;
+
+    void insert(Entry entry);
+    // Look up without counting; moves a found entry to the front
+    const Entry* touch(const Key& key);
+    void evict_to(std::size_t limit);
+    void erase(std::list<Entry>::iterator it);
+};
+
+#endif //DISTANCE_CACHE_H
@@ -0,0 +1,85 @@
+#ifndef DISTANCE_MATRIX_H
+#define DISTANCE_MATRIX_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "traversal_workspace.h"
+
+/**
+ * Contiguous n x n all-pairs distance store with the narrowest cells that hold the distances seen so far.
+ * It starts with uint8 cells and widens to uint16 or uint32 the first time a longer distance is stored;
+ * the all-ones value of the current width marks unreachable pairs.
+ * Rows may be written from several threads at once (each thread its own rows); widening takes
+ * an exclusive lock, so it is safe while other rows are being written.
+ */
+class DistanceMatrix {
+public:
+    DistanceMatrix() = default;
+    explicit DistanceMatrix(int vertices) { reset(vertices); }
+
+    // Moving is not synchronised with writers
+    DistanceMatrix(DistanceMatrix&& other) noexcept { *this = std::move(other); }
+    DistanceMatrix& operator=(DistanceMatrix&& other) noexcept;
+
+    // n x n pairs, all unreachable, 8-bit cells
+    void reset(int vertices);
+
+    [[nodiscard]] int size() const { return n; }
+    [[nodiscard]] bool empty() const { return n == 0; }
+
+    // Bytes per cell: 1, 2 or 4
+    [[nodiscard]] int cell_bytes() const;
+    [[nodiscard]] std::size_t bytes() const { return static_cast<std::size_t>(n) * n * cell_bytes(); }
+
+    // Distance from i to j, -1 if unreachable
+    [[nodiscard]] int at(int i, int j) const;
+
+    // Decode row i into out (n values, -1 for unreachable)
+    void copy_row(int i, std::span<int> out) const;
+
+    // Largest stored distance (0 when nothing is reachable)
+    [[nodiscard]] int max_distance() const;
+
+    // Widen the cells if needed so that distances up to distance fit
+    void ensure_fits(int distance);
+
+    // Store the vertices reached by the workspace's last search into row source: O(touched)
+    void store_row(int source, const TraversalWorkspace& workspace);
+
+    /**
+     * Run f with a typed pointer to the cells (f must accept uint8_t*, uint16_t* and uint32_t*),
+     * holding off widening meanwhile. Call ensure_fits for the largest distance f writes first.
+     */
+    template <class F>
+    void write(F&& f) {
+        std::shared_lock lock(mutex);
+        std::visit([&](auto& cells) { f(cells.data()); }, storage);
+    }
+
+    // Largest distance a cell of type Cell can hold: all ones is reserved for unreachable
+    template <class Cell>
+    static constexpr int max_storable() {
+        return static_cast<int>(std::min<std::uint32_t>(std::numeric_limits<Cell>::max() - 1u, std::numeric_limits<int>::max()));
+    }
+
+private:
+    using Storage = std::variant<std::vector<std::uint8_t>, std::vector<std::uint16_t>, std::vector<std::uint32_t>>;
+
+    int n = 0;
+    Storage storage;
+    std::atomic<int> capacity{0};
+    mutable std::shared_mutex mutex;
+
+    void widen(int distance);
+};
+
+#endif //DISTANCE_MATRIX_H
@@ -0,0 +1,21 @@
+#ifndef DOBFS_H
+#define DOBFS_H
+
+#include "graph_gen.h"
+
+/**
+ * Direction-optimizing breadth-first search for finding distances.
+ * Small frontiers are expanded top-down over the CSR arrays; once the frontier
+ * holds a large share of the remaining edges, levels are computed bottom-up by
+ * letting every unvisited vertex look for a parent in the frontier bitmap
+ * (a word-wise AND against its matrix row when the matrix is present).
+ * @param vertex Start vertex
+ * @param graph Currently being examined graph
+ * @param workspace Workspace sized for the graph; holds the distances afterwards
+ */
+extern void BFSD_do(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+
+// Same as BFSD_do without printing the traversal order (SearchKernel signature)
+extern void BFSD_do_no_print(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+
+#endif //DOBFS_H
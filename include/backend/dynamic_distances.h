@@ -0,0 +1,60 @@
+#ifndef DYNAMIC_DISTANCES_H
+#define DYNAMIC_DISTANCES_H
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include "graph_gen.h"
+
+/**
+ * Single-source BFS distance vectors kept valid while edges are added to or removed from the graph.
+ * A change only re-propagates the BFS levels below the vertices whose distance it can affect,
+ * so small edge deltas on a big graph cost far less than repeating the searches.
+ * Distances are -1 for unreachable vertices, as everywhere else.
+ */
+class DynamicDistances {
+public:
+    // Keep the distances from source (replaces an earlier result for the same source)
+    void track(int source, std::vector<int> distances);
+
+    // Forget every result (the graph was replaced)
+    void clear();
+
+    // Distances from source, or nullptr if they are not tracked
+    [[nodiscard]] const std::vector<int>* find(int source) const;
+
+    [[nodiscard]] std::size_t sources() const { return results.size(); }
+
+    // Sources with tracked distances, ascending
+    [[nodiscard]] std::vector<int> tracked_sources() const;
+
+    /**
+     * Repair every tracked result after the edge u-v was added to the graph
+     * @param graph Graph that already contains the edge (its CSR arrays are used)
+     * @return Number of distances that changed, over all tracked sources
+     */
+    long long edge_added(const Graph& graph, int u, int v);
+
+    /**
+     * Repair every tracked result after the edge u-v was removed from the graph
+     * @param graph Graph that no longer contains the edge (its CSR arrays are used)
+     * @return Number of distances that changed, over all tracked sources
+     */
+    long long edge_removed(const Graph& graph, int u, int v);
+
+private:
+    std::map<int, std::vector<int>> results;
+
+    // Scratch reused across repairs
+    std::vector<int> queue;
+    std::vector<int> affected;
+    std::vector<int> previous;
+    std::vector<char> is_affected;
+    std::vector<std::vector<int>> levels;
+
+    long long repair_insert(const CSRAdjacency& csr, std::vector<int>& dist, int u, int v);
+    long long repair_remove(const CSRAdjacency& csr, std::vector<int>& dist, int u, int v);
+};
+
+#endif //DYNAMIC_DISTANCES_H
@@ -0,0 +1,91 @@
+#ifndef GENERATORS_H
+#define GENERATORS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "graph_gen.h"
+
+// Synthetic graph families for create --model
+enum class GraphModel { ER, RMAT, BA, Grid };
+
+struct GeneratorOptions {
+    GraphModel model = GraphModel::ER;
+    int n = 5;
+    // Erdős–Rényi: edge and self-loop probabilities
+    double edge_prob = 0.5;
+    double loop_prob = 0.3;
+    // R-MAT: n * edge_factor sampled edges, quadrant probabilities a, b, c (d = 1 - a - b - c)
+    int edge_factor = 16;
+    double a = 0.57;
+    double b = 0.19;
+    double c = 0.19;
+    // Barabási–Albert: edges every new vertex attaches with
+    int attach = 4;
+    // Grid: rows x cols lattice
+    int rows = 0;
+    int cols = 0;
+    // Edge weights drawn from [1, max_weight] (0 - unweighted)
+    std::uint32_t max_weight = 0;
+    // Seed for random generator (0 - time based)
+    unsigned int seed = 0;
+};
+
+// Generated graphs get no adjacency matrix when it would take more than this many bytes
+constexpr std::size_t GENERATED_MATRIX_LIMIT = std::size_t{1} << 30;
+
+// Lower-case model names used in commands and reports ("er", "rmat", "ba", "grid")
+extern const char* model_name(GraphModel model);
+
+/**
+ * Parse create arguments:
+ *      [--model er] <n> <edgeProb> <loopProb>
+ *      --model rmat <n> [--edge-factor F] [--a A] [--b B] [--c C]
+ *      --model ba <n> [--attach M]
+ *      --model grid <rows> <cols>
+ * each optionally followed by --weights W (random edge weights in [1, W]) and --seed S
+ * @throws std::invalid_argument on an unknown option, a missing value or parameters out of range
+ */
+extern GeneratorOptions parse_generator_options(const std::vector<std::string>& args);
+
+/**
+ * Generate a graph of the chosen model into the matrix, list and CSR representations.
+ * Every random decision is a Philox draw indexed by the edge it belongs to, so edges are drawn
+ * in parallel and the graph is identical for the same options regardless of the thread count.
+ * R-MAT and Barabási–Albert drop self-loops and repeated edges; Erdős–Rényi is create_graph.
+ * For every model the matrix is left out above GENERATED_MATRIX_LIMIT bytes. With max_weight set the edges get
+ * assign_random_weights weights from the same seed.
+ * @param options Model and its parameters
+ * @param job Optional job to report drawn edges to; throws JobCancelled once it is cancelled
+ * @return New Graph
+ */
+extern Graph generate_graph(const GeneratorOptions& options, JobControl* job = nullptr);
+
+/**
+ * Build the list and CSR representations, and the matrix up to GENERATED_MATRIX_LIMIT bytes, from undirected edges.
+ * Both directions are stored and every row is sorted and duplicate-free.
+ * @param n Vertex count; every endpoint must be in [0, n)
+ * @param edges Edges in any order, repeats allowed
+ * @param keep_loops Keep self-loops (dropped otherwise)
+ * @param job Optional job; throws JobCancelled once it is cancelled
+ */
+extern Graph graph_from_edges(int n, std::span<const std::pair<int, int>> edges, bool keep_loops, JobControl* job = nullptr);
+
+/**
+ * Set the weights of a graph built by graph_from_edges from the same edges; both directions of an edge get
+ * its weight and an edge listed more than once keeps the smallest. Runs in parallel over the edges.
+ * @param graph Graph with CSR arrays holding exactly the given edges
+ * @param edges Edges passed to graph_from_edges
+ * @param weights Weight of every edge, at least 1
+ */
+extern void assign_edge_weights(Graph& graph, std::span<const std::pair<int, int>> edges, std::span<const std::uint32_t> weights);
+
+// Print vertex and edge counts, degree skew, the weight range and whether the matrix was built
+extern void print_generated(const Graph& graph, const GeneratorOptions& options, std::ostream& output);
+
+#endif //GENERATORS_H
@@ -5,77 +5,237 @@
 #ifndef GRAPH_GEN_H
 #define GRAPH_GEN_H
 
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <span>
+#include <string>
 #include <vector>
 
+#include "bit_matrix.h"
+#include "csr.h"
+#include "traversal_workspace.h"
+
+class DistanceMatrix;
+class JobControl;
+
+// Process-wide unique graph version, never 0
+extern std::uint64_t next_graph_version();
+
 struct Graph {
-    int** adj_matrix;
+    BitMatrix adj_matrix;
     std::vector<std::vector<int>> adj_list;
+    CSRAdjacency adj_csr;
+    // Weight of every CSR entry (weights[i] belongs to adj_csr.neighbours()[i], both directions of an edge
+    // carry the same weight); empty for unweighted graphs, whose edges all weigh 1
+    std::vector<std::uint32_t> weights;
     int n;
+    // Original id of every vertex after a reorder; empty while the vertices keep their original ids
+    std::vector<int> original_ids;
+    // Inverse of original_ids: current id of every original vertex
+    std::vector<int> current_ids;
+    // Identifies the graph contents for cached results: fresh for every new graph, bumped by every edit
+    std::uint64_t version = next_graph_version();
 };
 
+// Id vertex v had before the graph was reordered; results are printed in these ids
+inline int original_id(const Graph& graph, const int v) {
+    return graph.original_ids.empty() ? v : graph.original_ids[v];
+}
+
+// Current id of the vertex that had the given original id
+inline int current_id(const Graph& graph, const int original) {
+    return graph.current_ids.empty() ? original : graph.current_ids[original];
+}
+
+// Whether the graph carries edge weights
+inline bool is_weighted(const Graph& graph) {
+    return !graph.weights.empty();
+}
+
+// Graph representations a traversal can run on
+enum class Representation { Matrix, List, CSR };
+
+// Traversal methods
+enum class Method { BFS, DFS, DOBFS, PBFS };
+
+// Whether the graph carries the given representation (loaded graphs may lack the matrix or the list)
+inline bool has_representation(const Graph& graph, const Representation representation) {
+    switch (representation) {
+        case Representation::Matrix: return !graph.adj_matrix.empty();
+        case Representation::List: return graph.n > 0 && static_cast<int>(graph.adj_list.size()) == graph.n;
+        case Representation::CSR: return !graph.adj_csr.empty();
+    }
+    return false;
+}
+
+// Lower-case names used in reports ("matrix", "list", "csr" and "bfs", "dfs", "dobfs", "pbfs")
+extern const char* representation_name(Representation representation);
+extern const char* method_name(Method method);
+
+// Report label of a search, e.g. "csr bfs" (just "dobfs" for direction-optimizing BFS)
+extern std::string search_label(Representation representation, Method method);
+
+// Seed for a graph generator: seed itself, or a time-based one (distinct for concurrent calls) for 0
+extern unsigned int generator_seed(unsigned int seed);
+
 /**
- * Function for allocating memory for a graph with edge generating probabilities
+ * Function for allocating memory for a graph with edge generating probabilities.
+ * Every vertex pair gets its own Philox draw, so rows are generated in parallel and the graph
+ * is identical for the same (n, edgeProb, loopProb, seed) regardless of the thread count.
+ * Sparser graphs (edgeProb < 0.3) use geometric skip sampling and cost O(n + m).
  * @param n Graph size
  * @param edgeProb Edge generating probability
  * @param loopProb Loop edge generating probability
- * @param seed Seed for random generator
+ * @param seed Seed for random generator (0 - time based)
+ * @param job Optional job to report generated rows to; throws JobCancelled once it is cancelled
+ * @param with_matrix Build the adjacency matrix too (only the list and CSR otherwise)
  * @return New Graph
  */
-extern Graph create_graph(int n, double edgeProb = 0.4, double loopProb = 0.15, unsigned int seed = 0);
+extern Graph create_graph(int n, double edgeProb = 0.4, double loopProb = 0.15, unsigned int seed = 0,
+                          JobControl* job = nullptr, bool with_matrix = true);
+
+/**
+ * Give every edge a weight drawn uniformly from [1, max_weight]. The weight is a Philox draw indexed by the
+ * pair of original vertex ids, so both directions agree and the same seed gives the same weights.
+ * @param graph Graph with CSR arrays; its weights are replaced
+ * @param max_weight Largest weight, at least 1
+ * @param seed Seed for random generator (0 - time based)
+ */
+extern void assign_random_weights(Graph& graph, std::uint32_t max_weight, unsigned int seed = 0);
+
+// Whether the graph has the undirected edge u-v
+extern bool has_edge(const Graph& graph, int u, int v);
+
+// Number of undirected edges (a loop counts once), from the sorted CSR rows
+extern long long edge_count(const Graph& graph);
+
+/**
+ * Add the undirected edge u-v (a loop when u == v) in place to every representation the graph has.
+ * Adjacency rows stay sorted; arrays viewing a mapped file are copied on the first change.
+ * Bumps the graph version.
+ * @param weight Weight of the new edge, kept only if the graph is weighted
+ * @return False if the edge was already there
+ * @throws std::out_of_range if u or v is not a vertex of the graph
+ */
+extern bool add_edge(Graph& graph, int u, int v, std::uint32_t weight = 1);
+
+/**
+ * Remove the undirected edge u-v in place from every representation the graph has and bump the graph version
+ * @return False if there was no such edge
+ * @throws std::out_of_range if u or v is not a vertex of the graph
+ */
+extern bool remove_edge(Graph& graph, int u, int v);
 
 // Function to display the matrix
-extern void print_matrix(int **matrix, int rows, int cols, const char *name);
+extern void print_matrix(const BitMatrix& matrix, const char *name);
 
-// Free matrix memory
-extern void delete_graph(Graph& graph, int n);
+// Free graph memory
+extern void delete_graph(Graph& graph);
 
 // Display adj list
 extern void print_list(const std::vector<std::vector<int>> &list, const char *name);
 
-/* Preparation algorithm for BFSD
- * Representations:
- *      * 0 - matrix
- *      * 1 - list
- * Methods:
- *      * 0 - BFS
- *      * 1 - DFS
+// Display CSR offsets and neighbours arrays
+extern void print_csr(const CSRAdjacency &csr, const char *name);
+
+/**
+ * Build CSR adjacency from an adjacency list in a single pass
+ * @param list Adjacency list
+ * @return CSR arrays with the same neighbour order as the list
+ */
+extern CSRAdjacency build_csr(const std::vector<std::vector<int>> &list);
+
+// Print a distance vector (indexed by current ids) in original vertex order under a "Distances vector:" header
+extern void print_distances(const Graph& graph, std::span<const int> distances, std::ostream& output = std::cout);
+
+/**
+ * Preparation algorithm for BFSD: runs the printing method on the representation and prints distances
+ * in original vertex ids. Its counters replace the recorded stats report.
+ * @param distances Optional output for the distance vector
+ * @return Traversal time in microseconds (printing of the distances is not included)
+ */
+long long prep(const Graph& graph, int vertex, Representation representation, Method method,
+               std::vector<int>* distances = nullptr);
+
+/**
+ * Time one search without any output and add its counters to the recorded stats report
+ * @return Kernel time in microseconds
  */
-long long prep(const Graph& graph, int vertex, bool representation, bool method);
+extern long long time_search(const Graph& graph, int vertex, Representation representation, Method method);
 
 /**
  * Implementation of a breadth-first search algorithm for finding distances
  * @param vertex Start vertex
  * @param graph Currently being examined graph
- * @param dist Vector of distances to all vertices from the original one
+ * @param workspace Workspace sized for the graph; holds the distances afterwards
  */
-extern void BFSD(int vertex, const Graph& graph, std::vector<int>& dist);
+extern void BFSD(int vertex, const Graph& graph, TraversalWorkspace& workspace);
 
 /**
  * Implementation of a breadth-first search algorithm for finding distances from adjacency list
  * @param vertex Start vertex
  * @param graph Currently being examined graph
- * @param dist Vector of distances to all vertices from the original one
+ * @param workspace Workspace sized for the graph; holds the distances afterwards
  */
-extern void BFSD_list(int vertex, const Graph& graph, std::vector<int>& dist);
+extern void BFSD_list(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+
+/**
+ * Implementation of a breadth-first search algorithm for finding distances from CSR arrays
+ * @param vertex Start vertex
+ * @param graph Currently being examined graph
+ * @param workspace Workspace sized for the graph; holds the distances afterwards
+ */
+extern void BFSD_csr(int vertex, const Graph& graph, TraversalWorkspace& workspace);
 
 /**
  * Implementation of a depth-first search algorithm for finding distances
  * @param vertex Start vertex
  * @param graph Currently being examined graph
- * @param dist Vector of distances to all vertices from the original one
+ * @param workspace Workspace sized for the graph; holds the distances afterwards
  */
-extern void DFSD(int vertex, const Graph& graph, std::vector<int>& dist);
+extern void DFSD(int vertex, const Graph& graph, TraversalWorkspace& workspace);
 
 /**
  * Implementation of a depth-first search algorithm for finding distances for adjacency list
  * @param vertex Start vertex
  * @param graph Currently being examined graph
- * @param dist Vector of distances to all vertices from the original one
+ * @param workspace Workspace sized for the graph; holds the distances afterwards
  */
-extern void DFSD_list(int vertex, const Graph& graph, std::vector<int>& dist);
+extern void DFSD_list(int vertex, const Graph& graph, TraversalWorkspace& workspace);
 
-// Method execution time comparison function
-extern void compare(const Graph& graph);
+/**
+ * Implementation of a depth-first search algorithm for finding distances for CSR arrays
+ * @param vertex Start vertex
+ * @param graph Currently being examined graph
+ * @param workspace Workspace sized for the graph; holds the distances afterwards
+ */
+extern void DFSD_csr(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+
+/**
+ * Search kernel used for timing and all-pairs runs: no output, leaves the distances in the
+ * workspace (read them with workspace.distance or export_distances)
+ */
+using SearchKernel = void (*)(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+
+extern void BFSD_no_print(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+extern void BFSD_list_no_print(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+extern void BFSD_csr_no_print(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+extern void DFSD_no_print(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+extern void DFSD_list_no_print(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+extern void DFSD_csr_no_print(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+
+// No-print kernel for a representation/method pair
+extern SearchKernel search_kernel(Representation representation, Method method);
+
+/**
+ * Method execution time comparison function
+ * @param graph Currently being examined graph
+ * @param threads Worker threads for the all-pairs runs (0 - all hardware threads, 1 - single-threaded only)
+ * @param output Stream the timings and tables are written to
+ * @param job Optional job to report finished sources to; throws JobCancelled once it is cancelled
+ * @param all_pairs Optional output for the BFS distance matrix (row i holds the distances from vertex i)
+ */
+extern void compare(const Graph& graph, int threads = 1, std::ostream& output = std::cout, JobControl* job = nullptr,
+                    DistanceMatrix* all_pairs = nullptr);
 #endif //GRAPH_GEN_H
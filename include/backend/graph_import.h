@@ -0,0 +1,53 @@
+#ifndef GRAPH_IMPORT_H
+#define GRAPH_IMPORT_H
+
+#include <ostream>
+#include <string>
+
+#include "graph_gen.h"
+
+// Text edge-list dialects read by import
+enum class EdgeListFormat { Auto, SNAP, MatrixMarket, EdgeList };
+
+// Names used in commands and reports ("auto", "snap", "mtx", "edgelist")
+extern const char* format_name(EdgeListFormat format);
+
+// @throws std::invalid_argument for an unknown name
+extern EdgeListFormat parse_edge_list_format(const std::string& name);
+
+struct ImportSummary {
+    // Dialect the file was parsed as
+    EdgeListFormat format = EdgeListFormat::Auto;
+    // Edge lines in the file, before symmetrizing and removing repeats
+    long long edges_read = 0;
+    // Vertex ids were renumbered to 0..n-1 (ascending file ids)
+    bool compacted = false;
+    // The third column was read as edge weights
+    bool weighted = false;
+    long long elapsed_us = 0;
+};
+
+/**
+ * Import an undirected graph from a text edge list.
+ *      * SNAP and plain edge lists: "u v" per line (tabs, spaces or a comma between the ids, extra columns
+ *        ignored), '#' and '%' comment lines; the ids that occur are compacted to 0..n-1 in ascending order
+ *      * Matrix Market: coordinate banner, "rows cols entries" size line, 1-based "i j [value]" entries;
+ *        ids are kept (shifted to 0-based) and n = max(rows, cols)
+ * The file is mapped and cut into chunks at line boundaries that are parsed in parallel with std::from_chars.
+ * Edges are symmetrized and repeats removed; self-loops are kept.
+ * @param path Input file
+ * @param format Dialect, Auto picks Matrix Market by its banner or the .mtx extension, SNAP by a leading '#'
+ * @param weighted Read the column after the ids (the Matrix Market value) as a positive integer edge weight;
+ *                 an edge listed more than once keeps its smallest weight
+ * @param summary Optional output for what was read
+ * @param job Optional job to report parsed chunks to; throws JobCancelled once it is cancelled
+ * @return New Graph with the list and CSR representations (and the matrix up to GENERATED_MATRIX_LIMIT)
+ * @throws std::runtime_error if the file cannot be read or has a malformed line
+ */
+extern Graph import_edge_list(const std::string& path, EdgeListFormat format = EdgeListFormat::Auto, bool weighted = false,
+                              ImportSummary* summary = nullptr, JobControl* job = nullptr);
+
+// Print vertex and edge counts, what was read and how long it took
+extern void print_import_summary(const Graph& graph, const ImportSummary& summary, std::ostream& output);
+
+#endif //GRAPH_IMPORT_H
@@ -0,0 +1,68 @@
+#ifndef GRAPH_IO_H
+#define GRAPH_IO_H
+
+#include <cstdint>
+#include <string>
+
+#include "graph_gen.h"
+
+/*
+ * Binary graph file, version 3 (native byte order, checked on load):
+ *      * header (GraphFileHeader, 128 bytes)
+ *      * CSR offsets, n + 1 int64 values
+ *      * CSR neighbours, int32 values
+ *      * optional edge weights, one uint32 per CSR neighbour
+ *      * optional original ids of a reordered graph, one int32 per vertex
+ *      * optional packed matrix, n rows of matrix_stride 64-bit words
+ * Every section starts on a 64-byte boundary, so a mapped file can be used in place.
+ * Older files still load: version 1 has neither weights nor original ids, version 2 has no original ids.
+ */
+struct GraphFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t flags;
+    std::uint32_t reserved0;
+    std::int64_t n;
+    std::int64_t entries;
+    std::uint64_t offsets_pos;
+    std::uint64_t neighbours_pos;
+    std::uint64_t matrix_pos;
+    std::uint64_t matrix_stride;
+    std::uint64_t file_size;
+    std::uint64_t weights_pos;
+    std::uint64_t permutation_pos;
+    std::uint8_t reserved[32];
+};
+
+static_assert(sizeof(GraphFileHeader) == 128, "Graph file header must stay 128 bytes");
+
+// Version 2 added the weights section and version 3 the original ids; older readers reject newer files
+// rather than drop what they do not know
+constexpr std::uint32_t GRAPH_FILE_VERSION = 3;
+constexpr std::uint32_t GRAPH_FILE_HAS_MATRIX = 1u << 0;
+constexpr std::uint32_t GRAPH_FILE_HAS_WEIGHTS = 1u << 1;
+constexpr std::uint32_t GRAPH_FILE_HAS_PERMUTATION = 1u << 2;
+
+/**
+ * Stream a graph to a binary file section by section
+ * @param graph Graph to save (must have CSR arrays)
+ * @param path Output file
+ * @param with_matrix Store the packed matrix too (ignored if the graph has none)
+ * @throws std::runtime_error on I/O failure
+ */
+extern void save_graph(const Graph& graph, const std::string& path, bool with_matrix = true);
+
+/**
+ * Map a binary graph file and use its CSR arrays (and matrix, if stored) in place.
+ * The adjacency list is not materialized for loaded graphs; stored weights and original ids are copied,
+ * so a reordered graph keeps reporting its original ids. Version 1 files load as unweighted graphs.
+ * By default only the header and the section bounds are checked, so loading does not touch the arrays.
+ * @param path Input file
+ * @param verify Also check every row and the matrix against the rows, O(n + m); for files that may be corrupted
+ * @return Graph viewing the mapped file
+ * @throws std::runtime_error if the file cannot be mapped or fails validation
+ */
+extern Graph load_graph(const std::string& path, bool verify = false);
+
+#endif //GRAPH_IO_H
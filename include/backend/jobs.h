@@ -0,0 +1,124 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Cancellation flag and progress counters shared between a running job and its watchers.
+ * Long loops call advance() as work items complete and stop early once cancel_requested() is set.
+ */
+class JobControl {
+public:
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+    [[nodiscard]] bool cancel_requested() const { return cancelled.load(std::memory_order_relaxed); }
+
+    // Add to the number of work items the job expects to complete
+    void expect(const long long items) { total.fetch_add(items, std::memory_order_relaxed); }
+    void advance(const long long items = 1) { done.fetch_add(items, std::memory_order_relaxed); }
+
+    [[nodiscard]] long long expected() const { return total.load(std::memory_order_relaxed); }
+    [[nodiscard]] long long completed() const { return done.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> cancelled{false};
+    std::atomic<long long> total{0};
+    std::atomic<long long> done{0};
+};
+
+// Thrown out of a job body when it notices the cancellation request
+class JobCancelled : public std::runtime_error {
+public:
+    JobCancelled() : std::runtime_error("job cancelled") {}
+};
+
+// Throw JobCancelled if the job was asked to stop (no-op when not running as a job)
+inline void job_checkpoint(const JobControl* job) {
+    if (job != nullptr && job->cancel_requested()) throw JobCancelled();
+}
+
+enum class JobState { Running, Done, Cancelled, Failed };
+
+/**
+ * Runs long commands on their own threads. Each job writes its report into a private buffer
+ * that is printed when the job is waited for, so the console stays usable meanwhile.
+ * Traversal counters recorded by a job are appended to that report instead of the shared one.
+ */
+class JobManager {
+public:
+    // Job body: writes its report to out, reports progress and checks cancellation through control
+    using Task = std::function<void(JobControl& control, std::ostream& out)>;
+
+    JobManager() = default;
+    ~JobManager();
+
+    JobManager(const JobManager&) = delete;
+    JobManager& operator=(const JobManager&) = delete;
+
+    /**
+     * Start a job on its own thread
+     * @param description Command line shown by list()
+     * @param unit Name of the work items the job reports progress in (e.g. "sources")
+     * @param task Job body
+     * @param on_wait Completion step run by wait() on the caller's thread if the job succeeded
+     * @return Job id
+     */
+    int submit(std::string description, std::string unit, Task task, std::function<void()> on_wait = {});
+
+    // Print state, progress and rate of every job that has not been waited for
+    void list(std::ostream& out) const;
+
+    // Ids of the jobs that have not been waited for, oldest first
+    [[nodiscard]] std::vector<int> ids() const;
+
+    // Request cancellation; false if there is no such job
+    bool cancel(int id);
+
+    // Request cancellation of every job and join them all
+    void cancel_all();
+
+    /**
+     * Block until the job finishes, printing its progress every second, then print its report,
+     * run its completion step and forget it
+     * @return Final state, or nothing if there is no such job
+     */
+    std::optional<JobState> wait(int id, std::ostream& out);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        int id = 0;
+        std::string description;
+        std::string unit;
+        JobControl control;
+        std::ostringstream output;
+        std::atomic<JobState> state{JobState::Running};
+        std::string error;
+        Clock::time_point started;
+        Clock::time_point finished;
+        std::function<void()> on_wait;
+        std::thread thread;
+    };
+
+    mutable std::mutex mutex;
+    std::condition_variable job_finished;
+    std::map<int, std::unique_ptr<Job>> jobs;
+    int next_id = 1;
+
+    static void print_progress(const Job& job, std::ostream& out);
+};
+
+#endif //JOBS_H
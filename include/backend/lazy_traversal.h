@@ -0,0 +1,53 @@
+#ifndef LAZY_TRAVERSAL_H
+#define LAZY_TRAVERSAL_H
+
+#include <climits>
+#include <ostream>
+
+#include "coroutine_generator.h"
+#include "graph_gen.h"
+
+// One vertex reached by a lazy traversal
+struct Discovery {
+    int vertex;
+    // BFS: shortest distance from the source; DFS: depth in the search tree
+    int distance;
+};
+
+/**
+ * Lazy breadth- or depth-first search: yields the vertices in the order BFSD/DFSD print them,
+ * BFS as soon as a vertex is discovered and DFS when it is taken from the stack.
+ * Only the part of the graph needed for the values pulled so far is expanded, so the range can be
+ * abandoned at any point; the workspace then holds the distances of the vertices discovered so far.
+ * @param graph Currently being examined graph; must outlive the range
+ * @param source Start vertex
+ * @param representation Adjacency to expand (matrix, list or CSR)
+ * @param method BFS or DFS
+ * @param workspace Workspace sized for the graph; must outlive the range and is not shared meanwhile
+ * @param max_depth Vertices at this distance (depth for DFS) are not expanded
+ * @throws std::invalid_argument for a method other than BFS or DFS
+ */
+extern Generator<Discovery> traverse(const Graph& graph, int source, Representation representation, Method method,
+                                     TraversalWorkspace& workspace, int max_depth = INT_MAX);
+
+// Stopping conditions of a limited traversal
+struct TraversalLimits {
+    // Do not go further than this distance (depth for DFS) from the source
+    int max_depth = INT_MAX;
+    // Stop once this vertex (current id) is reached, -1 - none
+    int until = -1;
+    // Stop after this many vertices
+    long long limit = LLONG_MAX;
+
+    [[nodiscard]] bool any() const { return max_depth != INT_MAX || until != -1 || limit != LLONG_MAX; }
+};
+
+/**
+ * Traverse lazily until a limit is hit and print the vertices reached with their distances
+ * in original ids, followed by why the traversal stopped
+ * @return Traversal time in microseconds (printing is not included)
+ */
+extern long long prep_limited(const Graph& graph, int source, Representation representation, Method method,
+                              const TraversalLimits& limits, std::ostream& output = std::cout);
+
+#endif //LAZY_TRAVERSAL_H
@@ -0,0 +1,78 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Alignment of the file contents in memory (page aligned when mapped)
+constexpr std::size_t MAPPED_FILE_ALIGNMENT = 64;
+
+// Whole file in memory: a private copy-on-write mapping, or a heap copy where mmap is unavailable
+struct MappedFile {
+    void* data = nullptr;
+    std::uint64_t size = 0;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) throw std::runtime_error("cannot open " + path);
+        size = static_cast<std::uint64_t>(in.tellg());
+        if (size == 0) throw std::runtime_error(path + " is empty");
+        data = ::operator new(size, std::align_val_t{MAPPED_FILE_ALIGNMENT});
+        in.seekg(0);
+        in.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+        if (!in) {
+            ::operator delete(data, std::align_val_t{MAPPED_FILE_ALIGNMENT});
+            throw std::runtime_error("cannot read " + path);
+        }
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open " + path);
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path);
+        }
+        // mmap rejects a zero length
+        if (st.st_size == 0) {
+            ::close(fd);
+            throw std::runtime_error(path + " is empty");
+        }
+        size = static_cast<std::uint64_t>(st.st_size);
+        // Private writable pages: in-place edits of a loaded graph never reach the file
+        data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            data = nullptr;
+            throw std::runtime_error("cannot map " + path);
+        }
+#endif
+    }
+
+    ~MappedFile() {
+        if (data == nullptr) return;
+#ifdef _WIN32
+        ::operator delete(data, std::align_val_t{MAPPED_FILE_ALIGNMENT});
+#else
+        ::munmap(data, size);
+#endif
+    }
+
+    [[nodiscard]] char* bytes() const { return static_cast<char*>(data); }
+};
+
+#endif //MAPPED_FILE_H
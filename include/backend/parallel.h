@@ -0,0 +1,53 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Number of hardware threads, never less than 1
+inline int hardware_threads() {
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+/**
+ * Run fn(index, thread_id) for every index in [begin, end) on a pool of worker threads.
+ * Indices are handed out in small chunks from a shared counter, so threads that finish
+ * early keep taking work from the rest of the range.
+ * @param begin First index
+ * @param end One past the last index
+ * @param threads Pool size (values below 1 run on the calling thread)
+ * @param fn Callable invoked as fn(int index, int thread_id)
+ * @param chunk Number of indices taken per counter increment
+ */
+template <class F>
+void parallel_for(const int begin, const int end, const int threads, F&& fn, const int chunk = 1) {
+    if (begin >= end) return;
+
+    const int pool_size = std::min(std::max(threads, 1), end - begin);
+    if (pool_size == 1) {
+        for (int i = begin; i < end; i++) fn(i, 0);
+        return;
+    }
+
+    std::atomic<int> next{begin};
+    auto worker = [&](const int thread_id) {
+        for (int first = next.fetch_add(chunk); first < end; first = next.fetch_add(chunk)) {
+            const int last = std::min(first + chunk, end);
+            for (int i = first; i < last; i++) fn(i, thread_id);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(pool_size - 1);
+    for (int t = 1; t < pool_size; t++) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+#endif //PARALLEL_H
@@ -0,0 +1,30 @@
+#ifndef PBFS_H
+#define PBFS_H
+
+#include "graph_gen.h"
+
+/**
+ * Parallel level-synchronous breadth-first search for finding distances from one source.
+ * The threads of one pool expand each frontier together, taking chunks of it from a shared counter;
+ * vertices are claimed in an atomic visited bitmap (a whole matrix word at a time over the matrix)
+ * and collected in per-thread buffers, which are copied into the next frontier at prefix-sum offsets.
+ * Distances match BFSD_list; the order of the vertices within one level depends on the scheduling.
+ * @param vertex Start vertex
+ * @param graph Currently being examined graph
+ * @param representation Adjacency the levels are expanded over (matrix, list or CSR)
+ * @param workspace Workspace sized for the graph; holds the distances afterwards
+ * @param threads Pool size (0 - all hardware threads)
+ */
+extern void BFSD_par(int vertex, const Graph& graph, Representation representation, TraversalWorkspace& workspace,
+                     int threads = 0);
+
+// Same as BFSD_par without printing the traversal order
+extern void BFSD_par_no_print(int vertex, const Graph& graph, Representation representation, TraversalWorkspace& workspace,
+                              int threads = 0);
+
+// SearchKernel forms of BFSD_par_no_print on all hardware threads
+extern void BFSD_par_matrix_no_print(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+extern void BFSD_par_list_no_print(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+extern void BFSD_par_csr_no_print(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+
+#endif //PBFS_H
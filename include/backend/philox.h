@@ -0,0 +1,56 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <array>
+#include <cstdint>
+
+/**
+ * Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+ * Every output block is a pure function of (key, counter), so any element of a random stream
+ * can be produced on any thread without sharing state, and the result is reproducible.
+ */
+class Philox4x32 {
+public:
+    using Block = std::array<std::uint32_t, 4>;
+
+    explicit Philox4x32(const std::uint64_t seed)
+        : key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)} {}
+
+    [[nodiscard]] Block operator()(Block counter) const {
+        std::array<std::uint32_t, 2> k = key;
+        for (int round = 0; round < 10; round++) {
+            const std::uint64_t p0 = static_cast<std::uint64_t>(MUL0) * counter[0];
+            const std::uint64_t p1 = static_cast<std::uint64_t>(MUL1) * counter[2];
+            counter = {
+                static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ k[0],
+                static_cast<std::uint32_t>(p1),
+                static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ k[1],
+                static_cast<std::uint32_t>(p0)
+            };
+            k[0] += WEYL0;
+            k[1] += WEYL1;
+        }
+        return counter;
+    }
+
+    // 64 random bits for the counter (a, b, stream)
+    [[nodiscard]] std::uint64_t bits(const std::uint32_t a, const std::uint32_t b, const std::uint32_t stream = 0) const {
+        const Block out = (*this)({a, b, stream, 0});
+        return static_cast<std::uint64_t>(out[0]) << 32 | out[1];
+    }
+
+    // Uniform double in (0, 1] for the counter (a, b, stream)
+    [[nodiscard]] double uniform(const std::uint32_t a, const std::uint32_t b, const std::uint32_t stream = 0) const {
+        return static_cast<double>((bits(a, b, stream) >> 11) + 1) * 0x1.0p-53;
+    }
+
+private:
+    static constexpr std::uint32_t MUL0 = 0xD2511F53;
+    static constexpr std::uint32_t MUL1 = 0xCD9E8D57;
+    static constexpr std::uint32_t WEYL0 = 0x9E3779B9;
+    static constexpr std::uint32_t WEYL1 = 0xBB67AE85;
+
+    std::array<std::uint32_t, 2> key;
+};
+
+#endif //PHILOX_H
@@ -0,0 +1,39 @@
+#ifndef REORDER_H
+#define REORDER_H
+
+#include <span>
+#include <vector>
+
+#include "graph_gen.h"
+
+// Vertex orderings for relabelling
+enum class Ordering {
+    RCM,    // reverse Cuthill-McKee: BFS from a minimum-degree vertex, neighbours by ascending degree, reversed
+    BFS,    // plain BFS discovery order, component by component
+    Degree, // descending degree, so hub rows sit together
+    None    // the original ids
+};
+
+/**
+ * Compute a locality-improving vertex permutation over the CSR arrays
+ * @param graph Graph to order
+ * @param ordering Ordering to compute
+ * @return new_id[v] for every current vertex v
+ */
+extern std::vector<int> vertex_ordering(const Graph& graph, Ordering ordering);
+
+/**
+ * Relabel the graph in place: vertex v becomes new_id[v] in the matrix, the list and the CSR arrays.
+ * Rows stay sorted, original ids are kept for printing and the graph version is bumped.
+ * @param graph Graph to relabel
+ * @param new_id Permutation of [0, n)
+ */
+extern void relabel_graph(Graph& graph, std::span<const int> new_id);
+
+// Mean |u - v| over all adjacency entries: how far apart neighbour data is stored
+extern double mean_neighbour_gap(const Graph& graph);
+
+// Largest |u - v| over all edges
+extern int graph_bandwidth(const Graph& graph);
+
+#endif //REORDER_H
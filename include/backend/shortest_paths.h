@@ -0,0 +1,57 @@
+#ifndef SHORTEST_PATHS_H
+#define SHORTEST_PATHS_H
+
+#include <cstdint>
+
+#include "graph_gen.h"
+
+// Weighted single-source shortest path engines
+enum class PathEngine { RadixHeap, DeltaStepping };
+
+// Names used in commands and reports ("dijkstra", "delta")
+extern const char* path_engine_name(PathEngine engine);
+
+// Largest edge weight (1 for unweighted graphs)
+extern std::uint32_t max_edge_weight(const Graph& graph);
+
+/**
+ * Weighted distances are kept in the int distance buffers of the workspace like hop counts.
+ * @throws std::overflow_error if a shortest path, bounded by (n - 1) * max_edge_weight, might not fit
+ */
+extern void check_weighted_range(const Graph& graph);
+
+/**
+ * Dijkstra's algorithm over the CSR arrays with a radix heap: keys are bucketed by the highest bit in which
+ * they differ from the last extracted key, so every entry moves down at most 32 times in total and a pop
+ * costs amortised O(log C) for the largest distance C. Outdated entries are skipped when popped.
+ * Edges of unweighted graphs weigh 1, which gives the BFS distances.
+ * @param vertex Start vertex
+ * @param graph Currently being examined graph; must pass check_weighted_range
+ * @param workspace Workspace sized for the graph; holds the weighted distances afterwards
+ */
+extern void dijkstra(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+
+/**
+ * Parallel delta-stepping: vertices are kept in buckets of width delta by tentative distance and the lowest
+ * non-empty bucket is relaxed by the whole pool at once, each thread taking chunks of it from a shared counter.
+ * Distances are lowered with an atomic compare-and-swap minimum and relaxed vertices go into per-thread
+ * buckets, which are merged into the next frontier at prefix-sum offsets. A bucket is repeated until
+ * no relaxation lands in it again, so the result equals dijkstra.
+ * @param vertex Start vertex
+ * @param graph Currently being examined graph; must pass check_weighted_range
+ * @param workspace Workspace sized for the graph; holds the weighted distances afterwards
+ * @param delta Bucket width (0 - max_edge_weight divided by the mean degree, at least 1)
+ * @param threads Pool size (0 - all hardware threads)
+ */
+extern void delta_stepping(int vertex, const Graph& graph, TraversalWorkspace& workspace, int delta = 0, int threads = 0);
+
+// SearchKernel form of delta_stepping on the calling thread, for pools that already split the sources
+extern void delta_stepping_single(int vertex, const Graph& graph, TraversalWorkspace& workspace);
+
+/**
+ * Time one weighted search without any output and add its counters to the recorded stats report
+ * @return Search time in microseconds
+ */
+extern long long time_shortest_paths(const Graph& graph, int vertex, PathEngine engine);
+
+#endif //SHORTEST_PATHS_H
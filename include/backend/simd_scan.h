@@ -0,0 +1,67 @@
+#ifndef SIMD_SCAN_H
+#define SIMD_SCAN_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bit_matrix.h"
+#include "traversal_workspace.h"
+
+/**
+ * Row scan kernel: fresh = row & ~visited, then visited |= fresh, over words 64-bit words
+ * (words is always a multiple of 8 for BitMatrix rows).
+ * @return true if the row contains at least one unvisited column
+ */
+using RowScanFn = bool (*)(const std::uint64_t* row, std::uint64_t* visited, std::uint64_t* fresh, std::size_t words);
+
+// Row scan kernel for the best instruction set of the running CPU (scalar, SSE4.2, AVX2 or AVX-512)
+extern RowScanFn row_scan;
+
+// Name of the instruction set row_scan was resolved to
+extern const char* row_scan_isa();
+
+/**
+ * Visited bitmap for matrix traversals. Each call to for_each_new hands out the columns of a
+ * matrix row that were not visited yet and marks them visited, using the SIMD row scan.
+ * The bitmaps live in the workspace, so repeated searches with one workspace do not allocate.
+ */
+class RowScanner {
+public:
+    RowScanner(const BitMatrix& adjacency, TraversalWorkspace& workspace);
+
+    void visit(const int v) { visited[v / BitMatrix::word_bits] |= BitMatrix::word_type{1} << (v % BitMatrix::word_bits); }
+
+    // Call f(j) for every unvisited column j of row i in ascending order
+    template <class F>
+    void for_each_new(const int i, F&& f) {
+        if (!row_scan(matrix.row(i), visited.data(), fresh.data(), words)) return;
+        for (std::size_t w = 0; w < words; w++) {
+            for (auto bits = fresh[w]; bits != 0; bits &= bits - 1) {
+                f(static_cast<int>(w * BitMatrix::word_bits) + std::countr_zero(bits));
+            }
+        }
+    }
+
+    // Call f(j) for every unvisited column j of row i in descending order
+    template <class F>
+    void for_each_new_reverse(const int i, F&& f) {
+        if (!row_scan(matrix.row(i), visited.data(), fresh.data(), words)) return;
+        for (std::size_t w = words; w-- > 0;) {
+            for (auto bits = fresh[w]; bits != 0;) {
+                const int bit = BitMatrix::word_bits - 1 - std::countl_zero(bits);
+                bits &= ~(BitMatrix::word_type{1} << bit);
+                f(static_cast<int>(w * BitMatrix::word_bits) + bit);
+            }
+        }
+    }
+
+private:
+    const BitMatrix& matrix;
+    std::size_t words;
+    std::vector<BitMatrix::word_type>& visited;
+    std::vector<BitMatrix::word_type>& fresh;
+};
+
+#endif //SIMD_SCAN_H
@@ -0,0 +1,78 @@
+#ifndef TEXT_BUFFER_H
+#define TEXT_BUFFER_H
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Buffered text output for large tables: numbers are formatted with std::to_chars into one
+ * reusable buffer that is handed to the stream in big write calls, instead of going through
+ * the stream (and std::endl flushes) cell by cell. Flushed when full, on flush() and on destruction.
+ */
+class TextBuffer {
+public:
+    explicit TextBuffer(std::ostream& stream, std::size_t capacity = 1 << 16);
+    ~TextBuffer();
+
+    TextBuffer(const TextBuffer&) = delete;
+    TextBuffer& operator=(const TextBuffer&) = delete;
+
+    TextBuffer& operator<<(char c) {
+        reserve(1);
+        data[used++] = c;
+        return *this;
+    }
+
+    TextBuffer& operator<<(std::string_view text);
+    TextBuffer& operator<<(const char* text) { return *this << std::string_view(text); }
+    TextBuffer& operator<<(const std::string& text) { return *this << std::string_view(text); }
+
+    template <std::integral T>
+    TextBuffer& operator<<(const T value) {
+        reserve(max_number_chars);
+        used = static_cast<std::size_t>(std::to_chars(data.data() + used, data.data() + data.size(), value).ptr - data.data());
+        return *this;
+    }
+
+    // Same formatting as an ostream with default flags (%g, 6 significant digits)
+    TextBuffer& operator<<(double value);
+
+    // Right-align value in a field of the given width
+    template <std::integral T>
+    TextBuffer& right(const T value, const int width) {
+        char digits[max_number_chars];
+        const auto length = static_cast<int>(std::to_chars(digits, digits + max_number_chars, value).ptr - digits);
+        if (width > length) repeat(' ', static_cast<std::size_t>(width - length));
+        return *this << std::string_view(digits, static_cast<std::size_t>(length));
+    }
+
+    // Append count copies of c
+    TextBuffer& repeat(char c, std::size_t count);
+
+    // Hand the buffered text to the stream and flush it
+    void flush();
+
+    // Characters needed to print value in decimal (including the minus sign)
+    static int width_of(long long value);
+
+private:
+    static constexpr std::size_t max_number_chars = 24;
+
+    std::ostream& out;
+    std::vector<char> data;
+    std::size_t used = 0;
+
+    void reserve(const std::size_t count) {
+        if (used + count > data.size()) drain();
+    }
+
+    // Write the buffered text to the stream without flushing it
+    void drain();
+};
+
+#endif //TEXT_BUFFER_H
@@ -0,0 +1,154 @@
+#ifndef TRAVERSAL_ENGINE_H
+#define TRAVERSAL_ENGINE_H
+
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <string_view>
+
+#include "graph_gen.h"
+#include "simd_scan.h"
+#include "text_buffer.h"
+
+/*
+ * Single-source search assembled from compile-time policies:
+ *      Rows     - adjacency of one representation: degree(u), mark(v) for the source, and
+ *                 for_each_new(u, f) / for_each_new_reverse(u, f), which hand out the unvisited
+ *                 neighbours of u in ascending / descending order (the callback then visits them)
+ *      Frontier - queue (BFS) or stack (DFS) held in the workspace; it also picks the scan direction,
+ *                 so the neighbours come out of the frontier in ascending order
+ *      Visitor  - expand(u) as u leaves the frontier and finish() at the end
+ * All calls are resolved at compile time, so with NullVisitor the search is the plain loop.
+ */
+
+// Adjacency matrix rows, scanned against the visited bitmap with the SIMD row scan
+class MatrixRows {
+public:
+    MatrixRows(const Graph& graph, TraversalWorkspace& workspace) : matrix(graph.adj_matrix), scanner(graph.adj_matrix, workspace) {}
+
+    [[nodiscard]] std::size_t degree(const int u) const { return matrix.row_count(u); }
+    void mark(const int v) { scanner.visit(v); }
+
+    template <class F>
+    void for_each_new(const int u, F&& f) { scanner.for_each_new(u, f); }
+
+    template <class F>
+    void for_each_new_reverse(const int u, F&& f) { scanner.for_each_new_reverse(u, f); }
+
+private:
+    const BitMatrix& matrix;
+    RowScanner scanner;
+};
+
+// Rows stored as int spans (adjacency list or CSR); RowOf::row(graph, u) returns the span of u
+template <class RowOf>
+class SpanRows {
+public:
+    SpanRows(const Graph& source, const TraversalWorkspace& visits) : graph(source), workspace(visits) {}
+
+    [[nodiscard]] std::size_t degree(const int u) const { return RowOf::row(graph, u).size(); }
+    void mark(int) {}
+
+    template <class F>
+    void for_each_new(const int u, F&& f) {
+        for (const int v : RowOf::row(graph, u)) {
+            if (!workspace.visited(v)) f(v);
+        }
+    }
+
+    template <class F>
+    void for_each_new_reverse(const int u, F&& f) {
+        const auto row = RowOf::row(graph, u);
+        for (auto it = row.rbegin(); it != row.rend(); ++it) {
+            if (const int v = *it; !workspace.visited(v)) f(v);
+        }
+    }
+
+private:
+    const Graph& graph;
+    const TraversalWorkspace& workspace;
+};
+
+struct ListRowOf {
+    static std::span<const int> row(const Graph& graph, const int u) { return graph.adj_list[u]; }
+};
+
+struct CSRRowOf {
+    static std::span<const int> row(const Graph& graph, const int u) { return graph.adj_csr.row(u); }
+};
+
+using ListRows = SpanRows<ListRowOf>;
+using CSRRows = SpanRows<CSRRowOf>;
+
+// Breadth-first: FIFO frontier
+struct QueueFrontier {
+    static void put(TraversalWorkspace& workspace, const int v) { workspace.enqueue(v); }
+    static int take(TraversalWorkspace& workspace) { return workspace.dequeue(); }
+    static bool empty(const TraversalWorkspace& workspace) { return workspace.queue_empty(); }
+
+    template <class Rows, class F>
+    static void scan(Rows& rows, const int u, F&& f) { rows.for_each_new(u, f); }
+};
+
+// Depth-first: LIFO frontier, vertices are marked when pushed so it never holds more than n entries
+struct StackFrontier {
+    static void put(TraversalWorkspace& workspace, const int v) { workspace.push(v); }
+    static int take(TraversalWorkspace& workspace) { return workspace.pop(); }
+    static bool empty(const TraversalWorkspace& workspace) { return workspace.stack_empty(); }
+
+    // Pushed in descending order, so the smallest neighbour is expanded next
+    template <class Rows, class F>
+    static void scan(Rows& rows, const int u, F&& f) { rows.for_each_new_reverse(u, f); }
+};
+
+// Timing and all-pairs runs: does nothing
+struct NullVisitor {
+    void expand(int) {}
+    void finish() {}
+};
+
+// Prints the traversal order in original ids after an optional header line
+class PrintVisitor {
+public:
+    PrintVisitor(const Graph& source, std::ostream& output, const std::string_view header = {}) : graph(source), out(output) {
+        out << header;
+    }
+
+    void expand(const int u) { out << original_id(graph, u) << ' '; }
+    void finish() { out << '\n'; }
+
+private:
+    const Graph& graph;
+    TextBuffer out;
+};
+
+/**
+ * Search from vertex with the given frontier and adjacency, leaving the distances in the workspace
+ * (BFS: hop distances, DFS: depths in the search tree)
+ * @param vertex Start vertex
+ * @param graph Currently being examined graph
+ * @param workspace Workspace sized for the graph
+ * @param visitor Visitor policy, called in traversal order
+ */
+template <class Frontier, class Rows, class Visitor>
+void run_search(const int vertex, const Graph& graph, TraversalWorkspace& workspace, Visitor&& visitor) {
+    workspace.begin();
+    Rows rows(graph, workspace);
+    workspace.visit(vertex, 0);
+    rows.mark(vertex);
+    Frontier::put(workspace, vertex);
+
+    while (!Frontier::empty(workspace)) {
+        const int current = Frontier::take(workspace);
+        workspace.count_edges(rows.degree(current));
+        const int next_depth = workspace.depth(current) + 1;
+        visitor.expand(current);
+        Frontier::scan(rows, current, [&](const int v) {
+            workspace.visit(v, next_depth);
+            Frontier::put(workspace, v);
+        });
+    }
+    visitor.finish();
+}
+
+#endif //TRAVERSAL_ENGINE_H
@@ -0,0 +1,88 @@
+#ifndef TRAVERSAL_STATS_H
+#define TRAVERSAL_STATS_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Kernel counters are compiled in only with -DENABLE_TRAVERSAL_STATS=ON (defines TRAVERSAL_STATS)
+#ifdef TRAVERSAL_STATS
+inline constexpr bool traversal_stats_enabled = true;
+#else
+inline constexpr bool traversal_stats_enabled = false;
+#endif
+
+// Work done by one or more searches
+struct TraversalStats {
+    long long searches = 0;
+    long long dequeued = 0;             // vertices taken from the queue/stack (or frontier) and expanded
+    long long edges_examined = 0;       // adjacency entries looked at while expanding
+    long long discoveries = 0;          // edges that reached an unvisited vertex
+    std::size_t peak_depth = 0;         // largest queue/stack/frontier size
+    std::vector<long long> level_sizes; // vertices discovered at each distance, summed over searches
+    long long cycles = -1;              // hardware counters, -1 when not measured
+    long long llc_misses = -1;
+
+    // Add the counters of other (peaks take the maximum)
+    void merge(const TraversalStats& other);
+};
+
+/**
+ * Hardware cycle and last-level cache miss counters of the calling thread, read through
+ * perf_event_open on Linux builds with -DENABLE_PERF_COUNTERS=ON. Counting starts on construction.
+ * Elsewhere, or when the kernel refuses access, the counters are reported as unavailable.
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // Stop counting and store the values into stats
+    void stop(TraversalStats& stats);
+
+private:
+    int cycles_fd = -1;
+    int misses_fd = -1;
+};
+
+// Stats of the methods run by one traversal or compare run
+struct StatsReport {
+    std::string title;
+    std::vector<std::pair<std::string, TraversalStats>> runs;
+};
+
+/**
+ * While alive, stats_begin/stats_record on the constructing thread go to a report of its own instead of
+ * the shared one that 'stats' prints. Background jobs run under one, so they never mix into a foreground report.
+ */
+class StatsScope {
+public:
+    StatsScope();
+    ~StatsScope();
+
+    StatsScope(const StatsScope&) = delete;
+    StatsScope& operator=(const StatsScope&) = delete;
+
+    // Print the collected report; nothing if no run was recorded or the counters are not compiled in
+    void print(std::ostream& out) const;
+
+private:
+    StatsReport report;
+    StatsReport* outer;
+};
+
+// Start a new recorded report (e.g. for one traversal or compare run), dropping the previous one
+extern void stats_begin(const std::string& title);
+
+// Add the stats of one method to the recorded report
+extern void stats_record(const std::string& method, const TraversalStats& stats);
+
+// Print the shared recorded report
+extern void print_stats(std::ostream& out);
+
+#endif //TRAVERSAL_STATS_H
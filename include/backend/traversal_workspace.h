@@ -0,0 +1,136 @@
+#ifndef TRAVERSAL_WORKSPACE_H
+#define TRAVERSAL_WORKSPACE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "bit_matrix.h"
+#include "traversal_stats.h"
+
+/**
+ * Reusable storage for single-source searches: a ring-buffer queue, an array stack, a distance
+ * buffer and a generation-stamped visited array, all sized once per graph.
+ * begin() starts a new search in O(1) by bumping the generation instead of re-filling with -1,
+ * so repeated searches on the same graph make no heap allocations.
+ */
+class TraversalWorkspace {
+public:
+    using Word = BitMatrix::word_type;
+
+    TraversalWorkspace() = default;
+    explicit TraversalWorkspace(int vertices);
+
+    // Size the buffers for a graph with the given vertex count (no-op when already large enough)
+    void prepare(int vertices);
+
+    // Start a new search: forget every visited vertex, empty the queue and the stack
+    void begin();
+
+    [[nodiscard]] int size() const { return n; }
+
+    [[nodiscard]] bool visited(const int v) const { return stamp[v] == generation; }
+
+    // Mark v visited at distance d and record it in the discovery order
+    void visit(const int v, const int d) {
+        stamp[v] = generation;
+        dist[v] = d;
+        order[touched++] = v;
+        if constexpr (traversal_stats_enabled) {
+            if (d > 0) stats.discoveries++;
+            if (stats.level_sizes.size() <= static_cast<std::size_t>(d)) stats.level_sizes.resize(d + 1, 0);
+            stats.level_sizes[d]++;
+        }
+    }
+
+    // Mark v reached at weighted distance d: visit without the per-distance level counts
+    void settle(const int v, const int d) {
+        stamp[v] = generation;
+        dist[v] = d;
+        order[touched++] = v;
+        if constexpr (traversal_stats_enabled) {
+            if (d > 0) stats.discoveries++;
+        }
+    }
+
+    // Distance of a visited vertex
+    [[nodiscard]] int depth(const int v) const { return dist[v]; }
+
+    // Distance of any vertex, -1 if the current search has not reached it
+    [[nodiscard]] int distance(const int v) const { return visited(v) ? dist[v] : -1; }
+
+    // Vertices reached by the current search in discovery order
+    [[nodiscard]] std::span<const int> touched_vertices() const { return {order.data(), touched}; }
+
+    // Write the distances of reached vertices into out, which must be pre-filled with -1: O(touched)
+    void export_distances(std::span<int> out) const;
+
+    // Write the distances of all vertices into out: O(n)
+    void export_all(std::span<int> out) const;
+
+    void enqueue(const int v) {
+        queue[tail++ & mask] = v;
+        note_depth(tail - head);
+    }
+    int dequeue() {
+        count_expanded();
+        return queue[head++ & mask];
+    }
+    [[nodiscard]] bool queue_empty() const { return head == tail; }
+
+    void push(const int v) {
+        stack[top++] = v;
+        note_depth(top);
+    }
+    int pop() {
+        count_expanded();
+        return stack[--top];
+    }
+    [[nodiscard]] bool stack_empty() const { return top == 0; }
+
+    // Counter hooks for the search kernels; they compile to nothing without TRAVERSAL_STATS
+    void count_expanded(const std::size_t vertices = 1) {
+        if constexpr (traversal_stats_enabled) stats.dequeued += static_cast<long long>(vertices);
+    }
+    void count_edges(const std::size_t edges) {
+        if constexpr (traversal_stats_enabled) stats.edges_examined += static_cast<long long>(edges);
+    }
+    void note_depth(const std::size_t depth) {
+        if constexpr (traversal_stats_enabled) stats.peak_depth = std::max(stats.peak_depth, depth);
+    }
+
+    // Counters accumulated over every search run with this workspace
+    TraversalStats stats;
+
+    // Scratch bitmaps for matrix row scans and frontier sets (resized by the searches that use them)
+    std::vector<Word> bits;
+    std::vector<Word> fresh_bits;
+
+    // Scratch frontiers for level-synchronous searches
+    std::vector<int> frontier;
+    std::vector<int> next_frontier;
+
+    // Scratch for weighted searches: tentative distances, the distance each vertex was last relaxed from
+    // and priority queue buckets
+    std::vector<int> labels;
+    std::vector<int> relaxed_at;
+    std::vector<std::vector<std::uint64_t>> buckets;
+
+private:
+    int n = 0;
+    std::uint32_t generation = 0;
+    std::vector<std::uint32_t> stamp;
+    std::vector<int> dist;
+    std::vector<int> order;
+    std::vector<int> queue;
+    std::vector<int> stack;
+    std::size_t touched = 0;
+    std::size_t head = 0;
+    std::size_t tail = 0;
+    std::size_t top = 0;
+    std::size_t mask = 0;
+};
+
+#endif //TRAVERSAL_WORKSPACE_H
@@ -72,7 +72,7 @@ public:
 
         while (running) {
             std::cout << get_color("info") << config.prompt << reset_color();
-            std::getline(std::cin, input);
+            if (!std::getline(std::cin, input)) break;
 
             if (input.empty()) continue;
 
@@ -82,8 +82,56 @@ public:
         }
     }
 
+    /**
+     * Run commands from a stream, one per line, until the input ends or exit is called.
+     * Blank lines and text after '#' are ignored; a failed command does not stop the run.
+     * @return Number of commands that failed
+     */
+    int run_batch(std::istream& input) {
+        running = true;
+        int failures = 0;
+        std::string line;
+
+        while (running && std::getline(input, line)) {
+            if (const auto comment = line.find('#'); comment != std::string::npos) {
+                line.erase(comment);
+            }
+            if (tokenize(line).empty()) continue;
+
+            add_to_history(line);
+            if (!execute(line)) failures++;
+        }
+
+        running = false;
+        return failures;
+    }
+
+    // Run one command line; false if the command is unknown, threw or reported a failure
+    bool execute(const std::string& input) {
+        command_failed = false;
+        process_input(input);
+        return !command_failed;
+    }
+
+    // Mark the command being executed as failed (for handlers that print their own errors)
+    void mark_failed() const {
+        command_failed = true;
+    }
+
+    // Batch mode: no prompts, colours, screen clearing, exit message or press-to-exit pause
+    void set_batch_mode(const bool enabled) {
+        batch = enabled;
+        if (batch) {
+            config.colors_enabled = false;
+            config.press_to_exit = false;
+            config.clear_screen_on_start = false;
+            config.show_help_on_unknown = false;
+        }
+    }
+
     void stop() {
         running = false;
+        if (batch) return;
         std::cout << get_color("success") << config.exit_msg << reset_color() << std::endl;
         if (config.press_to_exit) {
             std::cout << "Press Enter to continue...";
@@ -157,6 +205,7 @@ public:
     }
 
     void clear_screen() {
+        if (batch) return;
 #ifdef _WIN32
         std::system("cls");
 #else
@@ -173,6 +222,8 @@ public:
 
 private:
     bool running;
+    bool batch = false;
+    mutable bool command_failed = false;
     std::deque<std::string> commands_history;
     ConsoleConfig config;
     std::deque<std::string> command_history;
@@ -234,9 +285,11 @@ private:
                 const std::vector<std::string> args(tokens.begin() + 1, tokens.end());
                 it->second.handler(args);
             } catch (const std::exception& e) {
+                command_failed = true;
                 std::cout << get_color("error") << "Error executing command: " << e.what() << reset_color() << std::endl;
             }
         } else {
+            command_failed = true;
             std::cout << get_color("error") << config.unknown_msg << ": " << commandName << reset_color() << std::endl;
             if (config.show_help_on_unknown) {
                 std::cout << "Type 'help' for available commands" << std::endl;
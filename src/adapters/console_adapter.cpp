@@ -9,6 +9,7 @@
 #include <windows.h>
 #include <shlobj.h>
 #else
+#include <pwd.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include <stdio.h>
@@ -16,13 +17,107 @@
 
 #include "../../include/adapters/console_adapter.h"
 #include "../../include/backend/graph_gen.h"
+#include "../../include/backend/bench.h"
+#include "../../include/backend/bidirectional.h"
+#include "../../include/backend/generators.h"
+#include "../../include/backend/graph_import.h"
+#include "../../include/backend/graph_io.h"
+#include "../../include/backend/lazy_traversal.h"
+#include "../../include/backend/reorder.h"
+#include "../../include/backend/shortest_paths.h"
+#include "../../include/backend/distance_cache.h"
+#include "../../include/backend/dynamic_distances.h"
+#include "../../include/backend/traversal_stats.h"
 
+#include <chrono>
+#include <climits>
 #include <filesystem>
 #include <fstream>
 #include <utility>
 
 namespace fs = std::filesystem;
 
+namespace {
+    // Remove every occurrence of flag from args; true if it was present
+    bool take_flag(std::vector<std::string>& args, const std::string& flag) {
+        const auto removed = std::erase(args, flag);
+        return removed > 0;
+    }
+
+    // Command line shown in the job list
+    std::string describe(const std::string& command, const std::vector<std::string>& args) {
+        std::string description = command;
+        for (const auto& arg : args) {
+            description += " " + arg;
+        }
+        return description;
+    }
+
+    void print_started(const int id) {
+        std::cout << "Started job [" << id << "], use 'jobs' to watch it and 'wait " << id << "' for the result" << std::endl;
+    }
+
+    // Time every single-source method from vertex v
+    void compare_vertex(const Graph& graph, const int v, std::ostream& out, JobControl* job) {
+        struct Run {
+            const char* title;
+            Representation representation;
+            Method method;
+        };
+        constexpr Run runs[] = {
+            {"Matrix BFS", Representation::Matrix, Method::BFS},
+            {"Matrix DFS", Representation::Matrix, Method::DFS},
+            {"List BFS", Representation::List, Method::BFS},
+            {"List DFS", Representation::List, Method::DFS},
+            {"CSR BFS", Representation::CSR, Method::BFS},
+            {"CSR DFS", Representation::CSR, Method::DFS},
+            {"Direction-optimizing BFS", Representation::CSR, Method::DOBFS},
+            {"Matrix parallel BFS", Representation::Matrix, Method::PBFS},
+            {"List parallel BFS", Representation::List, Method::PBFS},
+        };
+        constexpr std::pair<const char*, PathEngine> weighted_runs[] = {
+            {"Radix-heap Dijkstra", PathEngine::RadixHeap},
+            {"Delta-stepping", PathEngine::DeltaStepping},
+        };
+        if (job != nullptr) job->expect(std::size(runs) + std::size(weighted_runs));
+        stats_begin("compare from vertex " + std::to_string(original_id(graph, v)));
+
+        for (const auto& [title, representation, method] : runs) {
+            job_checkpoint(job);
+            out << "===" << title << "===" << std::endl;
+            if (!has_representation(graph, representation)) {
+                out << "Skipped: representation not loaded" << std::endl << std::endl;
+                continue;
+            }
+
+            const auto time = time_search(graph, v, representation, method);
+            if (job != nullptr) job->advance();
+
+            const double timeSec = static_cast<double>(time) / 1000000.0;
+            out << "Time: " << time << " us, or " << timeSec << " s" << std::endl;
+            out << std::endl;
+        }
+
+        for (const auto& [title, engine] : weighted_runs) {
+            job_checkpoint(job);
+            out << "===" << title << "===" << std::endl;
+            try {
+                check_weighted_range(graph);
+            } catch (const std::overflow_error& e) {
+                out << "Skipped: " << e.what() << std::endl << std::endl;
+                continue;
+            }
+
+            const auto time = time_shortest_paths(graph, v, engine);
+            if (job != nullptr) job->advance();
+
+            const double timeSec = static_cast<double>(time) / 1000000.0;
+            out << "Time: " << time << " us, or " << timeSec << " s" << std::endl;
+            out << std::endl;
+        }
+    }
+}
+
 GraphConsoleAdapter::GraphConsoleAdapter(const std::string& config_path, const std::string& aliases_path): graphs_created(false), graph(nullptr), n(0) {
     // const std::string config_file = ("../../resources/config_files/graph_console.conf");
     // const std::string aliases_file = ("../../resources/config_files/aliases.conf");
@@ -68,15 +163,27 @@ void GraphConsoleAdapter::run() {
     console.run();
 }
 
+int GraphConsoleAdapter::run_batch(std::istream& input) {
+    console.set_batch_mode(true);
+    return console.run_batch(input);
+}
+
 void GraphConsoleAdapter::cleanup() {
-    if (graph != nullptr) {
-        delete_graph(*graph, graph->n);
-        graph.reset();
-    }
+    // Background jobs hold their own reference, so the graph is freed once the last of them is done
+    graph.reset();
+    distances.clear();
     n = 0;
     graphs_created = false;
 }
 
+void GraphConsoleAdapter::adopt_graph(std::shared_ptr<Graph> created) {
+    cleanup();
+    graph = std::move(created);
+    n = graph->n;
+    cache.retain_only(graph->version);
+    graphs_created = true;
+}
+
 void GraphConsoleAdapter::cmd_smile() {
     std::cout << R"(
      /\     /\
@@ -124,8 +231,10 @@ void GraphConsoleAdapter::register_graph_commands() {
     console.register_command("create",
             [this](const std::vector<std::string>& args) { this->cmd_create(args); },
             "Create a new graph system",
-            {"vertices", "edge_probability", "loop_probability"},
-            "create <n> <edgeProb> <loopProb>"
+            {"vertices", "edge_probability", "loop_probability", "--model (er || rmat || ba || grid)",
+             "--edge-factor F, --a A, --b B, --c C (rmat)", "--attach M (ba)", "<rows> <cols> (grid)",
+             "--weights W (random edge weights in [1, W])", "--seed S", "--bg (run as a background job)"},
+            "create <n> <edgeProb> <loopProb> | create --model rmat|ba <n> | create --model grid <rows> <cols> [--weights W] [--seed S] [--bg]"
         );
 
     console.register_command("print",
@@ -168,56 +277,189 @@ void GraphConsoleAdapter::register_graph_commands() {
     console.register_command("traversal",
         [this](const std::vector<std::string>& args) { cmd_traversal(args); },
         "Traverse graph",
-        {"start vertex", "--representation (m || l)", "--method (bfs || dfs)"}
+        {"start vertex", "--representation (m || l || csr)", "--method (bfs || dfs || dobfs || pbfs)",
+         "--max-depth D (do not go further than D)", "--until V (stop once V is reached)", "--limit K (stop after K vertices)"},
+        "traversal <v> [--m|--l|--csr] [--bfs|--dfs|--dobfs|--pbfs] [--max-depth D] [--until V] [--limit K]"
+    );
+
+    console.register_command("dijkstra",
+        [this](const std::vector<std::string>& args) { cmd_dijkstra(args); },
+        "Weighted shortest distances from a vertex (edges of unweighted graphs weigh 1)",
+        {"start vertex", "--delta-stepping (parallel delta-stepping instead of the radix-heap Dijkstra)",
+         "--delta D (bucket width, 0 - from the weights and degree)", "--threads T (0 - all cores)"},
+        "dijkstra <v> [--delta-stepping] [--delta D] [--threads T]"
+    );
+
+    console.register_command("distance",
+        [this](const std::vector<std::string>& args) { cmd_distance(args); },
+        "Distance between two vertices by bidirectional BFS, or for every pair in a file",
+        {"u", "v", "--file <pairs> (one \"u v\" pair per line)"},
+        "distance <u> <v> | distance --file <pairs>"
+    );
+
+    console.register_command("bench",
+        [this](const std::vector<std::string>& args) { cmd_bench(args); },
+        "Benchmark traversals over a grid of sizes, probabilities, representations and methods",
+        {"--n 500,2000", "--p 0.01,0.4", "--rep m,l,csr", "--method bfs,dfs,dobfs,pbfs", "--loop P", "--seed S",
+         "--warmup W", "--reps R", "--current (benchmark the current graph)", "--csv <file|->", "--json <file|->",
+         "--bg (run as a background job)"},
+        "bench [--n ...] [--p ...] [--rep ...] [--method ...] [--reps R] [--current] [--csv file] [--json file] [--bg]"
+    );
+
+    console.register_command("save",
+        [this](const std::vector<std::string>& args) { cmd_save(args); },
+        "Save current graph to a binary file",
+        {"file", "--no-matrix"},
+        "save <file> [--no-matrix]"
+    );
+
+    console.register_command("load",
+        [this](const std::vector<std::string>& args) { cmd_load(args); },
+        "Map a binary graph file and use it in place",
+        {"file", "--verify (check every row and the matrix before use)"},
+        "load <file> [--verify]"
+    );
+
+    console.register_command("import",
+        [this](const std::vector<std::string>& args) { cmd_import(args); },
+        "Import a text edge list (SNAP, Matrix Market or plain \"u v\" lines)",
+        {"file", "--format (snap || mtx || edgelist, detected when omitted)",
+         "--weighted (third column, or the Matrix Market value, is a positive integer weight)", "--bg (run as a background job)"},
+        "import <file> [--format snap|mtx|edgelist] [--weighted] [--bg]"
+    );
+
+    console.register_command("reorder",
+        [this](const std::vector<std::string>& args) { cmd_reorder(args); },
+        "Relabel the vertices for memory locality (results keep the original ids)",
+        {"rcm || bfs || degree || none"},
+        "reorder <rcm|bfs|degree|none>"
+    );
+
+    console.register_command("add-edge",
+        [this](const std::vector<std::string>& args) { cmd_edit_edge(args, true); },
+        "Add an edge to the graph in place and repair the tracked distances",
+        {"u", "v", "weight (weighted graphs, default 1)"},
+        "add-edge <u> <v> [weight]"
+    );
+
+    console.register_command("del-edge",
+        [this](const std::vector<std::string>& args) { cmd_edit_edge(args, false); },
+        "Remove an edge from the graph in place and repair the tracked distances",
+        {"u", "v"},
+        "del-edge <u> <v>"
     );
 
     console.register_command("compare",
         [this](const std::vector<std::string>& args) { cmd_compare(args); },
         "Compare methods of traversal",
-        {"start_vertex"}
+        {"start_vertex", "--threads N (0 - all cores)", "--bg (run as a background job)"},
+        "compare [start_vertex] [--threads N] [--bg]"
+    );
+
+    console.register_command("cache",
+        [this](const std::vector<std::string>& args) { cmd_cache(args); },
+        "Show the distance cache, change its memory budget or clear it",
+        {"budget <MiB>", "clear"},
+        "cache [budget <MiB> | clear]"
+    );
+
+    console.register_command("stats",
+        [this](const std::vector<std::string>&) { cmd_stats(); },
+        "Show the traversal counters of the last traversal or compare run"
+    );
+
+    console.register_command("jobs",
+        [this](const std::vector<std::string>&) { cmd_jobs(); },
+        "List background jobs with their progress"
+    );
+
+    console.register_command("wait",
+        [this](const std::vector<std::string>& args) { cmd_wait(args); },
+        "Wait for a background job and print its output (all jobs without an id)",
+        {"job id"},
+        "wait [id]"
+    );
+
+    console.register_command("cancel",
+        [this](const std::vector<std::string>& args) { cmd_cancel(args); },
+        "Ask a background job to stop",
+        {"job id"},
+        "cancel <id>"
     );
 }
 
-void GraphConsoleAdapter::cmd_create(const std::vector<std::string>& args) {
+void GraphConsoleAdapter::cmd_create(const std::vector<std::string>& arguments) {
     try {
-        const int new_n = args.empty() ? 5 : std::stoi(args[0]);
-        const double new_edge_prob = args.size() > 1 ?  std::stod(args[1]) : 0.5;
-        const double new_loop_prob = args.size() > 2 ?  std::stod(args[2]) : 0.3;
-
+        std::vector<std::string> args = arguments;
+        const bool background = take_flag(args, "--bg");
+        GeneratorOptions options = parse_generator_options(args);
+        const bool uniform = options.model == GraphModel::ER;
 
-        if (new_n <= 0) {
+        if (options.n <= 0) {
             std::cout << "Invalid number of vertices." << std::endl;
+            console.mark_failed();
             return;
         }
-        if (new_edge_prob <= 0 || new_edge_prob > 1 || new_loop_prob <= 0 || new_loop_prob > 1) {
+        if (uniform && (options.edge_prob <= 0 || options.edge_prob > 1 || options.loop_prob <= 0 || options.loop_prob > 1)) {
             std::cout << "Probabilities must be between 0 and 1" << std::endl;
+            console.mark_failed();
             return;
         }
 
-        cleanup();
+        // Synthetic models report the seed they used, so a run can be repeated with --seed
+        if (!uniform) options.seed = generator_seed(options.seed);
+        auto report = [options, uniform](const Graph& created, std::ostream& out) {
+            if (!uniform) {
+                print_generated(created, options, out);
+                return;
+            }
+            out << "Created two graphs with " << created.n << " vertices" << std::endl;
+            out << "  Edge probability: " << options.edge_prob << ", Loop probability: " << options.loop_prob << std::endl;
+            if (is_weighted(created)) out << "  Edge weights: 1.." << options.max_weight << std::endl;
+            if (created.adj_matrix.empty()) {
+                out << "  Adjacency matrix skipped: it would take more than " << (GENERATED_MATRIX_LIMIT >> 20) << " MiB" << std::endl;
+            }
+        };
 
-        n = new_n;
-        graph = std::make_unique<Graph>(create_graph(n, new_edge_prob, new_loop_prob, 0));
-        graphs_created = true;
+        if (background) {
+            // The new graph replaces the current one when the job is waited for
+            auto created = std::make_shared<std::shared_ptr<Graph>>();
+            const int id = jobs.submit(describe("create", args), uniform ? "rows" : "edges",
+                [created, options, report](JobControl& control, std::ostream& out) {
+                    *created = std::make_shared<Graph>(generate_graph(options, &control));
+                    report(**created, out);
+                },
+                [this, created] { adopt_graph(std::move(*created)); });
+            print_started(id);
+            return;
+        }
 
-        std::cout << "Created two graphs with " << n << " vertices" << std::endl;
-        std::cout << "  Edge probability: " << new_edge_prob << ", Loop probability: " << new_loop_prob << std::endl;
+        cleanup();
+        adopt_graph(std::make_shared<Graph>(generate_graph(options)));
+        report(*graph, std::cout);
 
     } catch (const std::exception& e) {
         std::cout << "Error creating graphs: " << e.what() << std::endl;
-        std::cout << "Usage: create <vertices> <edge_probability> <loop_probability>" << std::endl;
+        std::cout << "Usage: create <vertices> <edge_probability> <loop_probability> | "
+                     "create --model rmat|ba <vertices> | create --model grid <rows> <cols> [--weights W] [--seed S]" << std::endl;
+        console.mark_failed();
     }
 }
 
 void GraphConsoleAdapter::cmd_print() const {
     if (!graphs_created) {
         std::cout << "No graphs created. Use 'create' command first." << std::endl;
+        console.mark_failed();
         return;
     }
 
     std::cout << "=== GRAPH ===" << std::endl;
-    print_matrix(graph->adj_matrix, graph->n, graph->n, "Adjacency Matrix");
-    print_list(graph->adj_list, "Adjacency List");
+    if (!graph->original_ids.empty()) {
+        std::cout << "Vertices are reordered: rows use current ids, 'reorder none' restores the original ones" << std::endl;
+    }
+    if (has_representation(*graph, Representation::Matrix)) print_matrix(graph->adj_matrix, "Adjacency Matrix");
+    if (has_representation(*graph, Representation::List)) print_list(graph->adj_list, "Adjacency List");
+    if (has_representation(*graph, Representation::CSR)) print_csr(graph->adj_csr, "CSR Adjacency");
 }
 
 void GraphConsoleAdapter::cmd_clear() {
@@ -246,93 +488,544 @@ void GraphConsoleAdapter::cmd_history() {
     console.show_history();
 }
 
-void GraphConsoleAdapter::cmd_traversal(const std::vector<std::string> &args) const {
+void GraphConsoleAdapter::cmd_traversal(const std::vector<std::string> &arguments) {
     if (!graphs_created) {
         std::cout << "No graphs created. Use 'create' command first." << std::endl;
+        console.mark_failed();
         return;
     }
 
     try {
+        TraversalLimits limits;
+        std::vector<std::string> args;
+        for (size_t i = 0; i < arguments.size(); i++) {
+            if (arguments[i] == "--max-depth" && i + 1 < arguments.size()) {
+                limits.max_depth = std::stoi(arguments[++i]);
+            } else if (arguments[i] == "--until" && i + 1 < arguments.size()) {
+                limits.until = std::stoi(arguments[++i]);
+            } else if (arguments[i] == "--limit" && i + 1 < arguments.size()) {
+                limits.limit = std::stoll(arguments[++i]);
+            } else {
+                args.push_back(arguments[i]);
+            }
+        }
+
         const int v = args.empty() ? 0 : std::stoi(args[0]);
         const std::string rep = args.size() > 1 ? args[1] : "--m";
         const std::string met = args.size() > 2 ? args[2] : "--bfs";
 
         if (v >= graph->n || v < 0) {
             std::cout << "Invalid number of vertices." << std::endl;
+            console.mark_failed();
+            return;
+        }
+        if (limits.max_depth < 0 || limits.limit < 1 || (limits.until != -1 && (limits.until < 0 || limits.until >= graph->n))) {
+            std::cout << "Invalid traversal limit." << std::endl;
+            console.mark_failed();
             return;
         }
-        if (rep != "--l" && rep != "--m") {
+        if (rep != "--l" && rep != "--m" && rep != "--csr") {
             std::cout << "Invalid representation." << std::endl;
+            console.mark_failed();
             return;
         }
-        if (met != "--bfs" && met != "--dfs") {
+        if (met != "--bfs" && met != "--dfs" && met != "--dobfs" && met != "--pbfs") {
             std::cout << "Invalid method." << std::endl;
+            console.mark_failed();
+            return;
+        }
+
+        const Representation representation = rep == "--m" ? Representation::Matrix
+                                            : rep == "--l" ? Representation::List
+                                            : Representation::CSR;
+        const Method method = met == "--bfs" ? Method::BFS
+                            : met == "--dfs" ? Method::DFS
+                            : met == "--dobfs" ? Method::DOBFS
+                            : Method::PBFS;
+
+        if (!has_representation(*graph, method == Method::DOBFS ? Representation::CSR : representation)) {
+            std::cout << "Representation is not available for this graph." << std::endl;
+            console.mark_failed();
             return;
         }
 
-        const bool representation = rep != "--m";
-        const bool method = met != "--bfs";
+        // Vertices are given and printed in original ids, the graph may be reordered
+        const int source = current_id(*graph, v);
 
-        prep(*graph, v, representation, method);
+        // Limited traversals stop early, so their partial distances are neither cached nor tracked
+        if (limits.any()) {
+            if (method != Method::BFS && method != Method::DFS) {
+                std::cout << "--max-depth, --until and --limit work with --bfs and --dfs only." << std::endl;
+                console.mark_failed();
+                return;
+            }
+            if (limits.until != -1) limits.until = current_id(*graph, limits.until);
+            const long long elapsed = prep_limited(*graph, source, representation, method, limits);
+            std::cout << "Traversal time: " << elapsed << " us" << std::endl;
+            return;
+        }
+
+        if (method == Method::DFS) {
+            prep(*graph, source, representation, method);
+            return;
+        }
+
+        // BFS distances do not depend on the representation, so any earlier result for this graph version serves
+        if (const auto cached = cache.find(graph->version, source)) {
+            std::cout << "Served from the distance cache, traversal skipped" << std::endl;
+            print_distances(*graph, cached.distances);
+            return;
+        }
+
+        // BFS results are true distances, kept up to date by add-edge/del-edge
+        std::vector<int> result;
+        prep(*graph, source, representation, method, &result);
+        cache.store(graph->version, source, result);
+        distances.track(source, std::move(result));
     } catch (const std::exception& e) {
         std::cout << "Error BFSD: " << e.what() << std::endl;
+        console.mark_failed();
     }
 }
 
-void GraphConsoleAdapter::cmd_compare(const std::vector<std::string>& args) const {
-    struct nullbuf : std::streambuf {
-        int overflow(int c) override {return c;}
-    };
+void GraphConsoleAdapter::cmd_dijkstra(const std::vector<std::string>& arguments) const {
+    const char* usage = "Usage: dijkstra <v> [--delta-stepping] [--delta D] [--threads T]";
+    if (!graphs_created) {
+        std::cout << "No graphs created. Use 'create' command first." << std::endl;
+        console.mark_failed();
+        return;
+    }
+
+    try {
+        std::vector<std::string> args = arguments;
+        const PathEngine engine = take_flag(args, "--delta-stepping") ? PathEngine::DeltaStepping : PathEngine::RadixHeap;
+        int delta = 0;
+        int threads = 0;
+        std::vector<std::string> positional;
+        for (size_t i = 0; i < args.size(); i++) {
+            if (args[i] == "--delta" && i + 1 < args.size()) {
+                delta = std::stoi(args[++i]);
+            } else if (args[i] == "--threads" && i + 1 < args.size()) {
+                threads = std::stoi(args[++i]);
+            } else {
+                positional.push_back(args[i]);
+            }
+        }
 
+        if (positional.size() != 1) {
+            std::cout << usage << std::endl;
+            console.mark_failed();
+            return;
+        }
+        const int v = std::stoi(positional[0]);
+        if (v >= n || v < 0) {
+            std::cout << "Invalid number of vertices." << std::endl;
+            console.mark_failed();
+            return;
+        }
+        if (delta < 0 || threads < 0) {
+            std::cout << "Delta and thread count must not be negative." << std::endl;
+            console.mark_failed();
+            return;
+        }
+        check_weighted_range(*graph);
+
+        // Weighted distances are not hop counts, so they stay out of the distance cache
+        TraversalWorkspace workspace(n);
+        PerfCounters counters;
+        const auto start = std::chrono::high_resolution_clock::now();
+        if (engine == PathEngine::RadixHeap) {
+            dijkstra(current_id(*graph, v), *graph, workspace);
+        } else {
+            delta_stepping(current_id(*graph, v), *graph, workspace, delta, threads);
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        counters.stop(workspace.stats);
+        stats_begin("dijkstra from vertex " + std::to_string(v));
+        stats_record(path_engine_name(engine), workspace.stats);
+
+        std::vector<int> result(n);
+        workspace.export_all(result);
+        print_distances(*graph, result);
+        std::cout << "Time: " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error dijkstra: " << e.what() << std::endl;
+        std::cout << usage << std::endl;
+        console.mark_failed();
+    }
+}
+
+void GraphConsoleAdapter::cmd_compare(const std::vector<std::string>& arguments) {
     if (!graphs_created) {
         std::cout << "No graphs created. Use 'create' command first." << std::endl;
+        console.mark_failed();
         return;
     }
 
     try {
-        nullbuf nb;
-        std::ostream devnull(&nb);
-        // const int v = args.empty() ? 0 : std::stoi(args[0]);
-        if (args.empty()) {
-            compare(*graph);
+        std::vector<std::string> args = arguments;
+        const bool background = take_flag(args, "--bg");
+        int threads = 1;
+        std::vector<std::string> positional;
+        for (size_t i = 0; i < args.size(); i++) {
+            if (args[i] == "--threads" && i + 1 < args.size()) {
+                threads = std::stoi(args[++i]);
+            } else {
+                positional.push_back(args[i]);
+            }
+        }
+
+        if (threads < 0) {
+            std::cout << "Invalid number of threads" << std::endl;
+            console.mark_failed();
             return;
         }
 
-        const int v = std::stoi(args[0]);
+        const int v = positional.empty() ? -1 : std::stoi(positional[0]);
 
-        if (v >= graph->n || v < 0) {
+        if (!positional.empty() && (v >= graph->n || v < 0)) {
             std::cout << "Invalid number of vertex" << std::endl;
+            console.mark_failed();
             return;
         }
 
-        std::streambuf* old = std::cout.rdbuf();
-        std::cout.rdbuf(devnull.rdbuf());
-        auto t1 = prep(*graph, v, false, false);
-        auto t2 = prep(*graph, v, false, true);
-        auto t3 = prep(*graph, v, true, false);
-        auto t4 = prep(*graph, v, true, true);
-        std::cout.rdbuf(old);
-
-        std::cout << "===Matrix BFS===" << std::endl;
-        double timeSec = static_cast<double>(t1) / 1000000.0;
-        std::cout << "Time: " << t1 << " us, or " << timeSec << " s" << std::endl;
-        std::cout << std::endl;
-
-        std::cout << "===Matrix DFS===" << std::endl;
-        timeSec = static_cast<double>(t2) / 1000000.0;
-        std::cout << "Time: " << t2 << " us, or " << timeSec << " s" << std::endl;
-        std::cout << std::endl;
-
-        std::cout << "===List BFS===" << std::endl;
-        timeSec = static_cast<double>(t3) / 1000000.0;
-        std::cout << "Time: " << t3 << " us, or " << timeSec << " s" << std::endl;
-        std::cout << std::endl;
-
-        std::cout << "===List DFS===" << std::endl;
-        timeSec = static_cast<double>(t4) / 1000000.0;
-        std::cout << "Time: " << t4 << " us, or " << timeSec << " s" << std::endl;
-        std::cout << std::endl;
+        // The job keeps its own reference, so replacing the current graph does not affect it
+        auto run = [this, snapshot = graph, threads, v](std::ostream& out, JobControl* job) {
+            if (v < 0) {
+                DistanceMatrix all_pairs;
+                compare(*snapshot, threads, out, job, &all_pairs);
+                cache.store_all_pairs(snapshot->version, std::move(all_pairs));
+            } else {
+                compare_vertex(*snapshot, current_id(*snapshot, v), out, job);
+            }
+        };
+
+        if (background) {
+            print_started(jobs.submit(describe("compare", args), v < 0 ? "sources" : "searches",
+                [run](JobControl& control, std::ostream& out) { run(out, &control); }));
+            return;
+        }
+        run(std::cout, nullptr);
     } catch (const std::exception& e) {
         std::cout << "Error traversal: " << e.what() << std::endl;
+        console.mark_failed();
+    }
+}
+
+void GraphConsoleAdapter::cmd_save(const std::vector<std::string>& args) const {
+    if (!graphs_created) {
+        std::cout << "No graphs created. Use 'create' command first." << std::endl;
+        console.mark_failed();
+        return;
+    }
+    if (args.empty()) {
+        std::cout << "Usage: save <file> [--no-matrix]" << std::endl;
+        console.mark_failed();
+        return;
+    }
+
+    try {
+        const bool with_matrix = !(args.size() > 1 && args[1] == "--no-matrix");
+        save_graph(*graph, args[0], with_matrix);
+        std::cout << "Graph saved to " << args[0] << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error saving graph: " << e.what() << std::endl;
+        console.mark_failed();
+    }
+}
+
+void GraphConsoleAdapter::cmd_load(const std::vector<std::string>& arguments) {
+    std::vector<std::string> args = arguments;
+    const bool verify = take_flag(args, "--verify");
+    if (args.size() != 1) {
+        std::cout << "Usage: load <file> [--verify]" << std::endl;
+        console.mark_failed();
+        return;
+    }
+
+    try {
+        adopt_graph(std::make_shared<Graph>(load_graph(args[0], verify)));
+
+        std::cout << "Loaded graph with " << n << " vertices and " << graph->adj_csr.neighbours().size()
+                  << " adjacency entries" << (graph->adj_matrix.empty() ? "" : " (with matrix)")
+                  << (is_weighted(*graph) ? " (weighted)" : "") << (verify ? ", verified" : "") << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error loading graph: " << e.what() << std::endl;
+        console.mark_failed();
+    }
+}
+
+void GraphConsoleAdapter::cmd_import(const std::vector<std::string>& arguments) {
+    std::vector<std::string> args = arguments;
+    const bool background = take_flag(args, "--bg");
+    const bool weighted = take_flag(args, "--weighted");
+    if (args.empty() || (args.size() != 1 && !(args.size() == 3 && args[1] == "--format"))) {
+        std::cout << "Usage: import <file> [--format snap|mtx|edgelist] [--weighted] [--bg]" << std::endl;
+        console.mark_failed();
+        return;
+    }
+
+    try {
+        const std::string path = args[0];
+        const EdgeListFormat format = args.size() == 3 ? parse_edge_list_format(args[2]) : EdgeListFormat::Auto;
+
+        if (background) {
+            // The imported graph replaces the current one when the job is waited for
+            auto imported = std::make_shared<std::shared_ptr<Graph>>();
+            const int id = jobs.submit(describe("import", args), "chunks",
+                [imported, path, format, weighted](JobControl& control, std::ostream& out) {
+                    ImportSummary summary;
+                    *imported = std::make_shared<Graph>(import_edge_list(path, format, weighted, &summary, &control));
+                    print_import_summary(**imported, summary, out);
+                },
+                [this, imported] { adopt_graph(std::move(*imported)); });
+            print_started(id);
+            return;
+        }
+
+        ImportSummary summary;
+        adopt_graph(std::make_shared<Graph>(import_edge_list(path, format, weighted, &summary)));
+        print_import_summary(*graph, summary, std::cout);
+    } catch (const std::exception& e) {
+        std::cout << "Error importing graph: " << e.what() << std::endl;
+        console.mark_failed();
+    }
+}
+
+void GraphConsoleAdapter::cmd_distance(const std::vector<std::string>& args) const {
+    const char* usage = "Usage: distance <u> <v> | distance --file <pairs>";
+    if (!graphs_created) {
+        std::cout << "No graphs created. Use 'create' command first." << std::endl;
+        console.mark_failed();
+        return;
+    }
+    if (args.size() < 2) {
+        std::cout << usage << std::endl;
+        console.mark_failed();
+        return;
+    }
+
+    try {
+        if (args[0] == "--file") {
+            std::ifstream pairs(args[1]);
+            if (!pairs) throw std::runtime_error("cannot open " + args[1]);
+            distance_batch(*graph, pairs, std::cout);
+            return;
+        }
+
+        const int u = std::stoi(args[0]);
+        const int v = std::stoi(args[1]);
+        if (u < 0 || u >= n || v < 0 || v >= n) {
+            throw std::out_of_range("vertex out of range [0, " + std::to_string(n) + ")");
+        }
+
+        BidirectionalWorkspace workspace;
+        const auto start = std::chrono::high_resolution_clock::now();
+        const int distance = bidirectional_distance(current_id(*graph, u), current_id(*graph, v), *graph, workspace);
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Distance " << u << " -> " << v << ": ";
+        if (distance == -1) {
+            std::cout << "unreachable";
+        } else {
+            std::cout << distance;
+        }
+        std::cout << " (visited " << workspace.visited() << " of " << n << " vertices, "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us)" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error distance: " << e.what() << std::endl;
+        std::cout << usage << std::endl;
+        console.mark_failed();
+    }
+}
+
+void GraphConsoleAdapter::cmd_reorder(const std::vector<std::string>& args) {
+    if (!graphs_created) {
+        std::cout << "No graphs created. Use 'create' command first." << std::endl;
+        console.mark_failed();
+        return;
+    }
+    const std::string name = args.empty() ? "" : args[0];
+    if (name != "rcm" && name != "bfs" && name != "degree" && name != "none") {
+        std::cout << "Usage: reorder <rcm|bfs|degree|none>" << std::endl;
+        console.mark_failed();
+        return;
+    }
+    if (graph.use_count() > 1) {
+        std::cout << "The graph is in use by a background job, wait for it first." << std::endl;
+        console.mark_failed();
+        return;
+    }
+
+    try {
+        const Ordering ordering = name == "rcm" ? Ordering::RCM
+                                : name == "bfs" ? Ordering::BFS
+                                : name == "degree" ? Ordering::Degree
+                                : Ordering::None;
+        const double gap_before = mean_neighbour_gap(*graph);
+        const int bandwidth_before = graph_bandwidth(*graph);
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        relabel_graph(*graph, vertex_ordering(*graph, ordering));
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        // Cached results use the old ids
+        distances.clear();
+        cache.retain_only(graph->version);
+
+        std::cout << "Reordered " << n << " vertices (" << name << ") in "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us" << std::endl;
+        std::cout << "  Mean neighbour gap: " << gap_before << " -> " << mean_neighbour_gap(*graph) << std::endl;
+        std::cout << "  Bandwidth: " << bandwidth_before << " -> " << graph_bandwidth(*graph) << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error reorder: " << e.what() << std::endl;
+        console.mark_failed();
+    }
+}
+
+void GraphConsoleAdapter::cmd_edit_edge(const std::vector<std::string>& args, const bool add) {
+    const char* usage = add ? "Usage: add-edge <u> <v> [weight]" : "Usage: del-edge <u> <v>";
+    if (!graphs_created) {
+        std::cout << "No graphs created. Use 'create' command first." << std::endl;
+        console.mark_failed();
+        return;
+    }
+    if (args.size() < 2) {
+        std::cout << usage << std::endl;
+        console.mark_failed();
+        return;
+    }
+    // Background jobs read the graph without locking, so it must not change under them
+    if (graph.use_count() > 1) {
+        std::cout << "The graph is in use by a background job, wait for it first." << std::endl;
+        console.mark_failed();
+        return;
+    }
+
+    try {
+        const int u = std::stoi(args[0]);
+        const int v = std::stoi(args[1]);
+        if (u < 0 || u >= n || v < 0 || v >= n) {
+            throw std::out_of_range("vertex out of range [0, " + std::to_string(n) + ")");
+        }
+        // Edges are given in original ids; the backend works on current ids
+        const long long weight = add && args.size() > 2 ? std::stoll(args[2]) : 1;
+        if (weight < 1 || weight > INT_MAX) {
+            throw std::out_of_range("weight out of range [1, " + std::to_string(INT_MAX) + "]");
+        }
+        const int from = current_id(*graph, u);
+        const int to = current_id(*graph, v);
+        const bool changed = add ? add_edge(*graph, from, to, static_cast<std::uint32_t>(weight)) : remove_edge(*graph, from, to);
+        if (!changed) {
+            std::cout << "Edge " << u << "-" << v << (add ? " already exists." : " does not exist.") << std::endl;
+            return;
+        }
+
+        const long long repaired = add ? distances.edge_added(*graph, from, to) : distances.edge_removed(*graph, from, to);
+        // Results of the previous version are dead; the repaired ones carry over to the new version
+        cache.retain_only(graph->version);
+        for (const int source : distances.tracked_sources()) {
+            cache.store(graph->version, source, *distances.find(source));
+        }
+        std::cout << (add ? "Added" : "Removed") << " edge " << u << "-" << v << std::endl;
+        if (distances.sources() > 0) {
+            std::cout << "  Repaired distances from " << distances.sources() << " source(s), "
+                      << repaired << " changed" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Error editing edge: " << e.what() << std::endl;
+        std::cout << usage << std::endl;
+        console.mark_failed();
+    }
+}
+
+void GraphConsoleAdapter::cmd_bench(const std::vector<std::string>& arguments) {
+    try {
+        std::vector<std::string> args = arguments;
+        const bool background = take_flag(args, "--bg");
+        const BenchOptions options = parse_bench_options(args);
+        if (options.use_current && !graphs_created) {
+            std::cout << "No graphs created. Use 'create' command first." << std::endl;
+            console.mark_failed();
+            return;
+        }
+
+        if (background) {
+            print_started(jobs.submit(describe("bench", args), "searches",
+                [options, snapshot = graph](JobControl& control, std::ostream& out) {
+                    report_bench(run_bench(options, snapshot.get(), &control), options, out);
+                }));
+            return;
+        }
+        report_bench(run_bench(options, graph.get()), options);
+    } catch (const std::exception& e) {
+        std::cout << "Error bench: " << e.what() << std::endl;
+        console.mark_failed();
+    }
+}
+
+void GraphConsoleAdapter::cmd_cache(const std::vector<std::string>& args) {
+    try {
+        if (!args.empty() && args[0] == "clear") {
+            cache.clear();
+        } else if (args.size() > 1 && args[0] == "budget") {
+            const double megabytes = std::stod(args[1]);
+            if (megabytes < 0) throw std::invalid_argument("negative budget");
+            cache.set_budget(static_cast<std::size_t>(megabytes * (1 << 20)));
+        } else if (!args.empty()) {
+            std::cout << "Usage: cache [budget <MiB> | clear]" << std::endl;
+            console.mark_failed();
+            return;
+        }
+        cache.print(std::cout);
+    } catch (const std::exception& e) {
+        std::cout << "Error cache: " << e.what() << std::endl;
+        console.mark_failed();
+    }
+}
+
+void GraphConsoleAdapter::cmd_stats() const {
+    print_stats(std::cout);
+}
+
+void GraphConsoleAdapter::cmd_jobs() const {
+    jobs.list(std::cout);
+}
+
+void GraphConsoleAdapter::cmd_wait(const std::vector<std::string>& args) {
+    try {
+        const std::vector<int> ids = args.empty() ? jobs.ids() : std::vector{std::stoi(args[0])};
+        for (const int id : ids) {
+            const auto state = jobs.wait(id, std::cout);
+            if (!state) {
+                std::cout << "No such job: " << id << std::endl;
+                console.mark_failed();
+            } else if (*state != JobState::Done) {
+                console.mark_failed();
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Error wait: " << e.what() << std::endl;
+        console.mark_failed();
+    }
+}
+
+void GraphConsoleAdapter::cmd_cancel(const std::vector<std::string>& args) {
+    if (args.empty()) {
+        std::cout << "Usage: cancel <job id>" << std::endl;
+        console.mark_failed();
+        return;
+    }
+
+    try {
+        if (const int id = std::stoi(args[0]); jobs.cancel(id)) {
+            std::cout << "Cancellation requested for job [" << id << "]" << std::endl;
+        } else {
+            std::cout << "No such job: " << id << std::endl;
+            console.mark_failed();
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Error cancel: " << e.what() << std::endl;
+        console.mark_failed();
     }
 }
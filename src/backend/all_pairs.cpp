@@ -0,0 +1,158 @@
+#include "../../include/backend/all_pairs.h"
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MSBFS_X86 1
+// The batch body is inlined into each ISA-specific entry point, so it is compiled for that ISA
+#define MSBFS_INLINE __attribute__((always_inline)) inline
+#else
+#define MSBFS_INLINE inline
+#endif
+
+TraversalStats all_pairs_distances(const Graph &graph, const SearchKernel kernel, const int threads, DistanceMatrix &dist_matrix,
+                                   JobControl *job) {
+    const int n = graph.n;
+    const int pool_size = threads > 0 ? threads : hardware_threads();
+    std::vector<TraversalWorkspace> workspaces(pool_size);
+
+    parallel_for(0, n, pool_size, [&](const int source, const int thread_id) {
+        if (job != nullptr && job->cancel_requested()) return;
+        TraversalWorkspace& workspace = workspaces[thread_id];
+        workspace.prepare(n);
+        kernel(source, graph, workspace);
+        dist_matrix.store_row(source, workspace);
+        if (job != nullptr) job->advance();
+    });
+
+    TraversalStats stats;
+    for (const auto& workspace : workspaces) {
+        stats.merge(workspace.stats);
+    }
+    return stats;
+}
+
+namespace {
+    using Word = std::uint64_t;
+
+    // Per-thread MS-BFS state: WORDS bitset words per vertex for seen, visit and visit_next
+    struct MsbfsState {
+        std::vector<Word> seen;
+        std::vector<Word> visit;
+        std::vector<Word> visit_next;
+    };
+
+    using BatchFn = void (*)(const Graph&, int, MsbfsState&, DistanceMatrix&, const JobControl*);
+
+    // One batch of WORDS * 64 sources
+    template <int WORDS>
+    MSBFS_INLINE void msbfs_batch(const Graph& graph, const int first_source, MsbfsState& state, DistanceMatrix& dist_matrix,
+                                  const JobControl* job) {
+        const int n = graph.n;
+        const std::size_t cells = static_cast<std::size_t>(n) * WORDS;
+        const int batch = std::min(WORDS * 64, n - first_source);
+        state.seen.assign(cells, 0);
+        state.visit.assign(cells, 0);
+        state.visit_next.assign(cells, 0);
+
+        for (int i = 0; i < batch; i++) {
+            const int source = first_source + i;
+            const Word bit = Word{1} << (i % 64);
+            state.seen[static_cast<std::size_t>(source) * WORDS + i / 64] |= bit;
+            state.visit[static_cast<std::size_t>(source) * WORDS + i / 64] |= bit;
+        }
+        dist_matrix.write([&](auto* matrix_cells) {
+            for (int source = first_source; source < first_source + batch; source++) {
+                matrix_cells[static_cast<std::size_t>(source) * n + source] = 0;
+            }
+        });
+
+        for (int level = 1; ; level++) {
+            // Push every vertex's visit set to its neighbours
+            for (int v = 0; v < n; v++) {
+                const Word* visit = &state.visit[static_cast<std::size_t>(v) * WORDS];
+                Word any = 0;
+                for (int w = 0; w < WORDS; w++) any |= visit[w];
+                if (any == 0) continue;
+
+                for (const int u : graph.adj_csr.row(v)) {
+                    Word* next = &state.visit_next[static_cast<std::size_t>(u) * WORDS];
+                    for (int w = 0; w < WORDS; w++) next[w] |= visit[w];
+                }
+            }
+
+            // Keep only sources that reach the vertex for the first time and record their distance
+            bool discovered = false;
+            dist_matrix.ensure_fits(level);
+            dist_matrix.write([&](auto* matrix_cells) {
+                using Cell = std::remove_pointer_t<decltype(matrix_cells)>;
+                for (int u = 0; u < n; u++) {
+                    Word* next = &state.visit_next[static_cast<std::size_t>(u) * WORDS];
+                    Word* seen = &state.seen[static_cast<std::size_t>(u) * WORDS];
+                    for (int w = 0; w < WORDS; w++) {
+                        Word fresh = next[w] & ~seen[w];
+                        next[w] = fresh;
+                        seen[w] |= fresh;
+                        if (fresh != 0) discovered = true;
+                        for (; fresh != 0; fresh &= fresh - 1) {
+                            const int source = first_source + w * 64 + std::countr_zero(fresh);
+                            matrix_cells[static_cast<std::size_t>(source) * n + u] = static_cast<Cell>(level);
+                        }
+                    }
+                }
+            });
+
+            if (!discovered || (job != nullptr && job->cancel_requested())) break;
+            state.visit.swap(state.visit_next);
+            std::fill(state.visit_next.begin(), state.visit_next.end(), 0);
+        }
+    }
+
+    void msbfs_batch_64(const Graph& graph, const int first_source, MsbfsState& state, DistanceMatrix& dist_matrix,
+                        const JobControl* job) {
+        msbfs_batch<1>(graph, first_source, state, dist_matrix, job);
+    }
+
+#ifdef MSBFS_X86
+    // Four words per vertex fill one 256-bit register
+    __attribute__((target("avx2")))
+    void msbfs_batch_256(const Graph& graph, const int first_source, MsbfsState& state, DistanceMatrix& dist_matrix,
+                         const JobControl* job) {
+        msbfs_batch<4>(graph, first_source, state, dist_matrix, job);
+    }
+#endif
+
+    struct BatchKernel {
+        BatchFn fn;
+        int sources;
+    };
+
+    BatchKernel resolve_batch() {
+#ifdef MSBFS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return {msbfs_batch_256, 256};
+#endif
+        return {msbfs_batch_64, 64};
+    }
+
+    const BatchKernel selected_batch = resolve_batch();
+}
+
+int msbfs_batch_size() {
+    return selected_batch.sources;
+}
+
+void all_pairs_msbfs(const Graph &graph, const int threads, DistanceMatrix &dist_matrix, JobControl *job) {
+    const int pool_size = threads > 0 ? threads : hardware_threads();
+    const int sources = selected_batch.sources;
+    const int batches = (graph.n + sources - 1) / sources;
+    std::vector<MsbfsState> states(pool_size);
+
+    parallel_for(0, batches, pool_size, [&](const int batch, const int thread_id) {
+        if (job != nullptr && job->cancel_requested()) return;
+        selected_batch.fn(graph, batch * sources, states[thread_id], dist_matrix, job);
+        if (job != nullptr) job->advance(std::min(sources, graph.n - batch * sources));
+    });
+}
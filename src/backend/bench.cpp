@@ -0,0 +1,272 @@
+#include "../../include/backend/bench.h"
+#include "../../include/backend/jobs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    std::vector<std::string> split_list(const std::string& value) {
+        std::vector<std::string> items;
+        std::stringstream ss(value);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            if (!item.empty()) items.push_back(item);
+        }
+        return items;
+    }
+
+    Representation parse_representation(const std::string& name) {
+        if (name == "m" || name == "matrix") return Representation::Matrix;
+        if (name == "l" || name == "list") return Representation::List;
+        if (name == "csr") return Representation::CSR;
+        throw std::invalid_argument("unknown representation: " + name);
+    }
+
+    Method parse_method(const std::string& name) {
+        if (name == "bfs") return Method::BFS;
+        if (name == "dfs") return Method::DFS;
+        if (name == "dobfs") return Method::DOBFS;
+        if (name == "pbfs") return Method::PBFS;
+        throw std::invalid_argument("unknown method: " + name);
+    }
+
+    std::size_t representation_bytes(const Graph& graph, const Representation representation) {
+        switch (representation) {
+            case Representation::Matrix: return graph.adj_matrix.bytes();
+            case Representation::List: {
+                std::size_t bytes = graph.adj_list.capacity() * sizeof(std::vector<int>);
+                for (const auto& row : graph.adj_list) bytes += row.capacity() * sizeof(int);
+                return bytes;
+            }
+            case Representation::CSR: return graph.adj_csr.bytes();
+        }
+        return 0;
+    }
+
+    // Edges scanned by a traversal: every adjacency entry of every reached vertex
+    long long edges_traversed(const Graph& graph, const TraversalWorkspace& workspace) {
+        long long edges = 0;
+        for (const int v : workspace.touched_vertices()) {
+            edges += graph.adj_csr.degree(v);
+        }
+        return edges;
+    }
+
+    // Nearest-rank percentile of sorted samples
+    double percentile(const std::vector<double>& sorted, const double q) {
+        const auto rank = static_cast<std::size_t>(std::ceil(q * static_cast<double>(sorted.size())));
+        return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+    }
+
+    void bench_graph(const Graph& graph, const double edge_prob, const BenchOptions& options, std::vector<BenchResult>& results,
+                     JobControl* job) {
+        const int n = graph.n;
+        TraversalWorkspace workspace(n);
+
+        for (const Representation representation : options.representations) {
+            for (const Method method : options.methods) {
+                // Direction-optimizing BFS has a single implementation, report it once under CSR
+                const bool applies = (method != Method::DOBFS || representation == Representation::CSR)
+                                  && has_representation(graph, representation) && has_representation(graph, Representation::CSR);
+                if (!applies) {
+                    if (job != nullptr) job->advance(options.warmup + options.repetitions);
+                    continue;
+                }
+
+                const SearchKernel kernel = search_kernel(representation, method);
+                std::vector<double> samples;
+                long long edges = 0;
+                double total_us = 0;
+
+                for (int r = 0; r < options.warmup + options.repetitions; r++) {
+                    job_checkpoint(job);
+                    const int source = static_cast<int>((static_cast<long long>(r) * 7919) % n);
+
+                    const auto start = std::chrono::steady_clock::now();
+                    kernel(source, graph, workspace);
+                    const auto end = std::chrono::steady_clock::now();
+                    if (job != nullptr) job->advance();
+
+                    if (r < options.warmup) continue;
+                    const double us = std::chrono::duration<double, std::micro>(end - start).count();
+                    samples.push_back(us);
+                    total_us += us;
+                    edges += edges_traversed(graph, workspace);
+                }
+
+                std::sort(samples.begin(), samples.end());
+                BenchResult result{};
+                result.n = n;
+                result.edge_prob = edge_prob;
+                result.representation = representation;
+                result.method = method;
+                result.repetitions = options.repetitions;
+                result.min_us = samples.front();
+                result.median_us = percentile(samples, 0.5);
+                result.p99_us = percentile(samples, 0.99);
+                result.edges_per_second = total_us > 0 ? static_cast<double>(edges) / (total_us / 1e6) : 0.0;
+                result.bytes_per_vertex = static_cast<double>(representation_bytes(graph, representation)) / n;
+                result.edges_traversed = edges / options.repetitions;
+                results.push_back(result);
+            }
+        }
+    }
+
+    // Restores the stream formatting changed by a report writer
+    struct FormatGuard {
+        std::ostream& out;
+        std::ios_base::fmtflags flags;
+        std::streamsize precision;
+
+        explicit FormatGuard(std::ostream& stream) : out(stream), flags(stream.flags()), precision(stream.precision()) {}
+        ~FormatGuard() {
+            out.flags(flags);
+            out.precision(precision);
+        }
+    };
+
+    // Write to the file at path, or to stdout for "-"
+    template <class Writer>
+    void write_report(const std::string& path, std::ostream& console, Writer&& writer) {
+        if (path.empty()) return;
+        if (path == "-") {
+            writer(console);
+            return;
+        }
+        std::ofstream out(path);
+        if (!out) throw std::runtime_error("cannot create " + path);
+        writer(out);
+        console << "Report written to " << path << std::endl;
+    }
+}
+
+BenchOptions parse_bench_options(const std::vector<std::string>& args) {
+    BenchOptions options;
+    for (std::size_t i = 0; i < args.size(); i++) {
+        const std::string& key = args[i];
+        if (key == "--current") {
+            options.use_current = true;
+            continue;
+        }
+        if (i + 1 >= args.size()) throw std::invalid_argument("missing value for " + key);
+        const std::string& value = args[++i];
+
+        if (key == "--n") {
+            options.sizes.clear();
+            for (const auto& item : split_list(value)) options.sizes.push_back(std::stoi(item));
+        } else if (key == "--p") {
+            options.edge_probs.clear();
+            for (const auto& item : split_list(value)) options.edge_probs.push_back(std::stod(item));
+        } else if (key == "--rep") {
+            options.representations.clear();
+            for (const auto& item : split_list(value)) options.representations.push_back(parse_representation(item));
+        } else if (key == "--method") {
+            options.methods.clear();
+            for (const auto& item : split_list(value)) options.methods.push_back(parse_method(item));
+        } else if (key == "--loop") {
+            options.loop_prob = std::stod(value);
+        } else if (key == "--seed") {
+            options.seed = static_cast<unsigned int>(std::stoul(value));
+        } else if (key == "--warmup") {
+            options.warmup = std::stoi(value);
+        } else if (key == "--reps") {
+            options.repetitions = std::stoi(value);
+        } else if (key == "--csv") {
+            options.csv_path = value;
+        } else if (key == "--json") {
+            options.json_path = value;
+        } else {
+            throw std::invalid_argument("unknown option " + key);
+        }
+    }
+
+    if (options.repetitions < 1 || options.warmup < 0) throw std::invalid_argument("repetitions must be positive");
+    for (const int size : options.sizes) {
+        if (size <= 0) throw std::invalid_argument("graph sizes must be positive");
+    }
+    for (const double p : options.edge_probs) {
+        if (p <= 0 || p > 1) throw std::invalid_argument("probabilities must be between 0 and 1");
+    }
+    return options;
+}
+
+std::vector<BenchResult> run_bench(const BenchOptions &options, const Graph *current, JobControl *job) {
+    std::vector<BenchResult> results;
+
+    if (job != nullptr) {
+        const std::size_t graphs = options.use_current ? 1 : options.sizes.size() * options.edge_probs.size();
+        job->expect(static_cast<long long>(graphs * options.representations.size() * options.methods.size())
+                    * (options.warmup + options.repetitions));
+    }
+
+    if (options.use_current) {
+        if (current == nullptr) throw std::invalid_argument("no current graph to benchmark");
+        const double density = static_cast<double>(current->adj_csr.neighbours().size())
+                             / (static_cast<double>(current->n) * current->n);
+        bench_graph(*current, density, options, results, job);
+        return results;
+    }
+
+    for (const int n : options.sizes) {
+        for (const double edge_prob : options.edge_probs) {
+            const Graph graph = create_graph(n, edge_prob, options.loop_prob, options.seed);
+            bench_graph(graph, edge_prob, options, results, job);
+        }
+    }
+    return results;
+}
+
+void print_bench_table(const std::vector<BenchResult> &results, std::ostream &out) {
+    const FormatGuard guard(out);
+    out << std::left << std::setw(8) << "n" << std::setw(9) << "p" << std::setw(8) << "rep" << std::setw(7) << "method"
+        << std::right << std::setw(12) << "min us" << std::setw(12) << "median us" << std::setw(12) << "p99 us"
+        << std::setw(12) << "MTEPS" << std::setw(12) << "B/vertex" << std::endl;
+    for (const auto& r : results) {
+        out << std::left << std::setw(8) << r.n << std::setprecision(4) << std::setw(9) << r.edge_prob
+            << std::setw(8) << representation_name(r.representation) << std::setw(7) << method_name(r.method)
+            << std::right << std::fixed << std::setprecision(1)
+            << std::setw(12) << r.min_us << std::setw(12) << r.median_us << std::setw(12) << r.p99_us
+            << std::setw(12) << r.edges_per_second / 1e6 << std::setw(12) << r.bytes_per_vertex
+            << std::defaultfloat << std::endl;
+    }
+}
+
+void write_bench_csv(const std::vector<BenchResult> &results, std::ostream &out) {
+    const FormatGuard guard(out);
+    out << std::setprecision(10);
+    out << "n,edge_prob,representation,method,repetitions,min_us,median_us,p99_us,edges_per_second,bytes_per_vertex,edges_traversed\n";
+    for (const auto& r : results) {
+        out << r.n << ',' << r.edge_prob << ',' << representation_name(r.representation) << ','
+            << method_name(r.method) << ',' << r.repetitions << ',' << r.min_us << ',' << r.median_us << ','
+            << r.p99_us << ',' << r.edges_per_second << ',' << r.bytes_per_vertex << ',' << r.edges_traversed << '\n';
+    }
+}
+
+void write_bench_json(const std::vector<BenchResult> &results, const BenchOptions &options, std::ostream &out) {
+    const FormatGuard guard(out);
+    out << std::setprecision(10);
+    out << "{\n  \"seed\": " << options.seed << ",\n  \"warmup\": " << options.warmup
+        << ",\n  \"loop_prob\": " << options.loop_prob << ",\n  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const auto& r = results[i];
+        out << "    {\"n\": " << r.n << ", \"edge_prob\": " << r.edge_prob
+            << ", \"representation\": \"" << representation_name(r.representation) << "\""
+            << ", \"method\": \"" << method_name(r.method) << "\""
+            << ", \"repetitions\": " << r.repetitions << ", \"min_us\": " << r.min_us
+            << ", \"median_us\": " << r.median_us << ", \"p99_us\": " << r.p99_us
+            << ", \"edges_per_second\": " << r.edges_per_second << ", \"bytes_per_vertex\": " << r.bytes_per_vertex
+            << ", \"edges_traversed\": " << r.edges_traversed << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+void report_bench(const std::vector<BenchResult> &results, const BenchOptions &options, std::ostream &console) {
+    print_bench_table(results, console);
+    write_report(options.csv_path, console, [&](std::ostream& out) { write_bench_csv(results, out); });
+    write_report(options.json_path, console, [&](std::ostream& out) { write_bench_json(results, options, out); });
+}
@@ -0,0 +1,116 @@
+#include "../../include/backend/bidirectional.h"
+#include "../../include/backend/text_buffer.h"
+
+#include <charconv>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    /**
+     * Expand one whole level of side, recording the shortest path through any vertex the other side has seen
+     * @return Best distance found through this level, -1 if the searches did not meet
+     */
+    int expand_level(const CSRAdjacency& csr, TraversalWorkspace& side, const TraversalWorkspace& other) {
+        std::vector<int>& frontier = side.frontier;
+        std::vector<int>& next = side.next_frontier;
+        next.clear();
+        side.count_expanded(frontier.size());
+        int best = -1;
+
+        for (const int u : frontier) {
+            side.count_edges(static_cast<std::size_t>(csr.degree(u)));
+            const int next_depth = side.depth(u) + 1;
+            for (const int neigh : csr.row(u)) {
+                if (side.visited(neigh)) continue;
+                side.visit(neigh, next_depth);
+                next.push_back(neigh);
+                if (other.visited(neigh)) {
+                    const int through = next_depth + other.depth(neigh);
+                    if (best == -1 || through < best) best = through;
+                }
+            }
+        }
+
+        side.note_depth(next.size());
+        frontier.swap(next);
+        return best;
+    }
+
+    // Parse "u v" from a query line; false for a blank or comment line
+    bool parse_pair(const std::string& line, const int line_number, int& u, int& v) {
+        const char* first = line.data();
+        const char* last = line.data() + line.size();
+        while (first != last && (*first == ' ' || *first == '\t')) first++;
+        if (first == last || *first == '#' || *first == '\r') return false;
+
+        auto [middle, error] = std::from_chars(first, last, u);
+        while (error == std::errc() && middle != last && (*middle == ' ' || *middle == '\t' || *middle == ',')) middle++;
+        if (error == std::errc()) error = std::from_chars(middle, last, v).ec;
+        if (error != std::errc()) {
+            throw std::runtime_error("line " + std::to_string(line_number) + ": expected \"u v\"");
+        }
+        return true;
+    }
+}
+
+int bidirectional_distance(const int source, const int target, const Graph& graph, BidirectionalWorkspace& workspace) {
+    TraversalWorkspace& forward = workspace.forward;
+    TraversalWorkspace& backward = workspace.backward;
+    forward.prepare(graph.n);
+    backward.prepare(graph.n);
+    forward.begin();
+    backward.begin();
+
+    forward.visit(source, 0);
+    backward.visit(target, 0);
+    if (source == target) return 0;
+    forward.frontier.assign(1, source);
+    backward.frontier.assign(1, target);
+
+    // Finishing the level in which the searches meet is enough: a shorter path would have met earlier
+    while (!forward.frontier.empty() && !backward.frontier.empty()) {
+        const bool grow_forward = forward.frontier.size() <= backward.frontier.size();
+        const int best = grow_forward ? expand_level(graph.adj_csr, forward, backward)
+                                      : expand_level(graph.adj_csr, backward, forward);
+        if (best != -1) return best;
+    }
+    return -1;
+}
+
+long long distance_batch(const Graph& graph, std::istream& pairs, std::ostream& output) {
+    BidirectionalWorkspace workspace;
+    TextBuffer out(output);
+    std::string line;
+    long long queries = 0;
+    long long connected = 0;
+    long long visited = 0;
+    long long total_us = 0;
+
+    for (int line_number = 1; std::getline(pairs, line); line_number++) {
+        int u = 0;
+        int v = 0;
+        if (!parse_pair(line, line_number, u, v)) continue;
+        if (u < 0 || u >= graph.n || v < 0 || v >= graph.n) {
+            throw std::runtime_error("line " + std::to_string(line_number) + ": vertex out of range [0, " +
+                                     std::to_string(graph.n) + ")");
+        }
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        const int distance = bidirectional_distance(current_id(graph, u), current_id(graph, v), graph, workspace);
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        total_us += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        visited += static_cast<long long>(workspace.visited());
+        queries++;
+        if (distance != -1) connected++;
+        out << u << ' ' << v << ' ' << distance << '\n';
+    }
+
+    out << "Answered " << queries << " queries (" << connected << " connected) in " << total_us << " us";
+    if (queries > 0) {
+        out << ", " << visited / queries << " of " << graph.n << " vertices visited on average";
+    }
+    out << '\n';
+    return queries;
+}
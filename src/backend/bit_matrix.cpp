@@ -0,0 +1,67 @@
+#include "../../include/backend/bit_matrix.h"
+
+#include <cstring>
+#include <new>
+#include <utility>
+
+BitMatrix::BitMatrix(const int vertices) {
+    reset(vertices);
+}
+
+BitMatrix::~BitMatrix() {
+    release();
+}
+
+BitMatrix::BitMatrix(BitMatrix&& other) noexcept
+    : data(std::exchange(other.data, nullptr)),
+      n(std::exchange(other.n, 0)),
+      stride(std::exchange(other.stride, 0)),
+      backing(std::move(other.backing)) {}
+
+BitMatrix& BitMatrix::operator=(BitMatrix&& other) noexcept {
+    if (this != &other) {
+        release();
+        data = std::exchange(other.data, nullptr);
+        n = std::exchange(other.n, 0);
+        stride = std::exchange(other.stride, 0);
+        backing = std::move(other.backing);
+    }
+    return *this;
+}
+
+void BitMatrix::reset(const int new_n) {
+    release();
+    if (new_n <= 0) return;
+
+    n = new_n;
+    stride = stride_for(new_n);
+    data = static_cast<word_type*>(::operator new(bytes(), std::align_val_t{alignment}));
+    std::memset(data, 0, bytes());
+}
+
+BitMatrix BitMatrix::view(word_type* words, const int vertices, const std::size_t row_stride,
+                          std::shared_ptr<const void> keep_alive) {
+    BitMatrix matrix;
+    matrix.data = words;
+    matrix.n = vertices;
+    matrix.stride = row_stride;
+    matrix.backing = std::move(keep_alive);
+    return matrix;
+}
+
+std::size_t BitMatrix::stride_for(const int vertices) {
+    // Round every row up to a whole cache line worth of words
+    constexpr std::size_t words_per_line = alignment / sizeof(word_type);
+    const std::size_t words = (static_cast<std::size_t>(vertices) + word_bits - 1) / word_bits;
+    return (words + words_per_line - 1) / words_per_line * words_per_line;
+}
+
+void BitMatrix::release() {
+    if (data != nullptr && backing == nullptr) {
+        ::operator delete(data, std::align_val_t{alignment});
+    }
+    backing.reset();
+    data = nullptr;
+    n = 0;
+    stride = 0;
+}
@@ -0,0 +1,104 @@
+#include "../../include/backend/distance_cache.h"
+
+#include <iomanip>
+
+namespace {
+    // Key source of an all-pairs matrix
+    constexpr int ALL_SOURCES = -1;
+}
+
+DistanceCache::Lookup DistanceCache::find(const std::uint64_t version, const int source) {
+    std::lock_guard lock(mutex);
+    if (const Entry* entry = touch({version, source})) {
+        hits++;
+        return {entry->distances, *entry->distances};
+    }
+
+    // Row `source` of a cached all-pairs matrix
+    if (const Entry* entry = touch({version, ALL_SOURCES}); entry != nullptr && source >= 0 && source < entry->matrix->size()) {
+        hits++;
+        auto row = std::make_shared<std::vector<int>>(entry->matrix->size());
+        entry->matrix->copy_row(source, *row);
+        const std::span<const int> distances(*row);
+        return {std::move(row), distances};
+    }
+
+    misses++;
+    return {};
+}
+
+void DistanceCache::store(const std::uint64_t version, const int source, std::vector<int> distances) {
+    const std::size_t bytes = distances.size() * sizeof(int) + sizeof(Entry);
+    std::lock_guard lock(mutex);
+    insert({{version, source}, std::make_shared<const std::vector<int>>(std::move(distances)), nullptr, bytes});
+}
+
+void DistanceCache::store_all_pairs(const std::uint64_t version, DistanceMatrix matrix) {
+    const std::size_t bytes = matrix.bytes() + sizeof(Entry);
+    std::lock_guard lock(mutex);
+    insert({{version, ALL_SOURCES}, nullptr, std::make_shared<const DistanceMatrix>(std::move(matrix)), bytes});
+}
+
+void DistanceCache::retain_only(const std::uint64_t version) {
+    std::lock_guard lock(mutex);
+    for (auto it = entries.begin(); it != entries.end();) {
+        const auto next = std::next(it);
+        if (it->key.first != version) erase(it);
+        it = next;
+    }
+}
+
+void DistanceCache::set_budget(const std::size_t budget_bytes) {
+    std::lock_guard lock(mutex);
+    budget = budget_bytes;
+    evict_to(budget);
+}
+
+void DistanceCache::clear() {
+    std::lock_guard lock(mutex);
+    entries.clear();
+    index.clear();
+    resident = 0;
+    hits = 0;
+    misses = 0;
+}
+
+void DistanceCache::print(std::ostream& out) const {
+    std::lock_guard lock(mutex);
+    const long long lookups = hits + misses;
+    out << std::fixed << std::setprecision(1);
+    out << "Distance cache: " << entries.size() << " results, "
+        << static_cast<double>(resident) / (1 << 20) << " of " << static_cast<double>(budget) / (1 << 20) << " MiB" << std::endl;
+    out << "  Lookups: " << lookups << ", hits: " << hits << ", hit rate: "
+        << (lookups > 0 ? 100.0 * static_cast<double>(hits) / static_cast<double>(lookups) : 0.0) << "%" << std::endl;
+    out << std::defaultfloat << std::setprecision(6);
+}
+
+void DistanceCache::insert(Entry entry) {
+    if (const auto it = index.find(entry.key); it != index.end()) erase(it->second);
+    if (entry.bytes > budget) return;
+
+    evict_to(budget - entry.bytes);
+    resident += entry.bytes;
+    entries.push_front(std::move(entry));
+    index.emplace(entries.front().key, entries.begin());
+}
+
+const DistanceCache::Entry* DistanceCache::touch(const Key& key) {
+    const auto it = index.find(key);
+    if (it == index.end()) return nullptr;
+    entries.splice(entries.begin(), entries, it->second);
+    return &*it->second;
+}
+
+void DistanceCache::evict_to(const std::size_t limit) {
+    while (resident > limit && !entries.empty()) {
+        erase(std::prev(entries.end()));
+    }
+}
+
+void DistanceCache::erase(const std::list<Entry>::iterator it) {
+    resident -= it->bytes;
+    index.erase(it->key);
+    entries.erase(it);
+}
@@ -0,0 +1,103 @@
+#include "../../include/backend/distance_matrix.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+DistanceMatrix& DistanceMatrix::operator=(DistanceMatrix&& other) noexcept {
+    if (this != &other) {
+        n = std::exchange(other.n, 0);
+        storage = std::exchange(other.storage, Storage());
+        capacity.store(other.capacity.exchange(0));
+    }
+    return *this;
+}
+
+void DistanceMatrix::reset(const int vertices) {
+    std::unique_lock lock(mutex);
+    n = vertices;
+    storage = std::vector<std::uint8_t>(static_cast<std::size_t>(n) * n, std::numeric_limits<std::uint8_t>::max());
+    capacity.store(max_storable<std::uint8_t>());
+}
+
+int DistanceMatrix::cell_bytes() const {
+    std::shared_lock lock(mutex);
+    return std::visit([](const auto& cells) { return static_cast<int>(sizeof(cells[0])); }, storage);
+}
+
+int DistanceMatrix::at(const int i, const int j) const {
+    std::shared_lock lock(mutex);
+    return std::visit([&](const auto& cells) {
+        const auto cell = cells[static_cast<std::size_t>(i) * n + j];
+        return cell == std::numeric_limits<std::decay_t<decltype(cell)>>::max() ? -1 : static_cast<int>(cell);
+    }, storage);
+}
+
+void DistanceMatrix::copy_row(const int i, const std::span<int> out) const {
+    std::shared_lock lock(mutex);
+    std::visit([&](const auto& cells) {
+        using Cell = std::decay_t<decltype(cells[0])>;
+        const Cell* row = cells.data() + static_cast<std::size_t>(i) * n;
+        for (int j = 0; j < n; j++) {
+            out[j] = row[j] == std::numeric_limits<Cell>::max() ? -1 : static_cast<int>(row[j]);
+        }
+    }, storage);
+}
+
+int DistanceMatrix::max_distance() const {
+    std::shared_lock lock(mutex);
+    return std::visit([](const auto& cells) {
+        using Cell = std::decay_t<decltype(cells[0])>;
+        Cell best = 0;
+        for (const Cell cell : cells) {
+            if (cell != std::numeric_limits<Cell>::max()) best = std::max(best, cell);
+        }
+        return static_cast<int>(best);
+    }, storage);
+}
+
+void DistanceMatrix::ensure_fits(const int distance) {
+    if (distance > capacity.load(std::memory_order_acquire)) widen(distance);
+}
+
+void DistanceMatrix::store_row(const int source, const TraversalWorkspace& workspace) {
+    const auto touched = workspace.touched_vertices();
+    int deepest = 0;
+    for (const int v : touched) {
+        deepest = std::max(deepest, workspace.depth(v));
+    }
+    ensure_fits(deepest);
+
+    write([&](auto* cells) {
+        using Cell = std::remove_pointer_t<decltype(cells)>;
+        Cell* row = cells + static_cast<std::size_t>(source) * n;
+        for (const int v : touched) {
+            row[v] = static_cast<Cell>(workspace.depth(v));
+        }
+    });
+}
+
+void DistanceMatrix::widen(const int distance) {
+    std::unique_lock lock(mutex);
+    // Another writer may have widened while this one waited
+    if (distance <= capacity.load()) return;
+
+    auto convert = [&]<class Wide>(Wide) {
+        Storage wide = std::visit([](const auto& cells) {
+            using Cell = std::decay_t<decltype(cells[0])>;
+            std::vector<Wide> result(cells.size());
+            std::transform(cells.begin(), cells.end(), result.begin(), [](const Cell cell) {
+                return cell == std::numeric_limits<Cell>::max() ? std::numeric_limits<Wide>::max() : static_cast<Wide>(cell);
+            });
+            return Storage(std::move(result));
+        }, storage);
+        storage = std::move(wide);
+        capacity.store(max_storable<Wide>(), std::memory_order_release);
+    };
+
+    if (distance <= max_storable<std::uint16_t>()) {
+        convert(std::uint16_t{});
+    } else {
+        convert(std::uint32_t{});
+    }
+}
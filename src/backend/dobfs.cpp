@@ -0,0 +1,110 @@
+#include "../../include/backend/dobfs.h"
+#include "../../include/backend/text_buffer.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+    // Switching thresholds from Beamer et al., "Direction-Optimizing Breadth-First Search"
+    constexpr std::int64_t ALPHA = 14;
+    constexpr std::int64_t BETA = 24;
+
+    using Word = BitMatrix::word_type;
+    constexpr int WORD_BITS = BitMatrix::word_bits;
+
+    bool has_parent_in(const Graph& graph, const int v, const std::vector<Word>& frontier_bits) {
+        if (!graph.adj_matrix.empty()) {
+            const Word* row = graph.adj_matrix.row(v);
+            for (std::size_t w = 0; w < frontier_bits.size(); w++) {
+                if (row[w] & frontier_bits[w]) return true;
+            }
+            return false;
+        }
+
+        for (const int u : graph.adj_csr.row(v)) {
+            if ((frontier_bits[u / WORD_BITS] >> (u % WORD_BITS)) & 1u) return true;
+        }
+        return false;
+    }
+
+    template <class OnVisit>
+    void direction_optimizing_bfs(const int vertex, const Graph& graph, TraversalWorkspace& workspace, OnVisit&& on_visit) {
+        const int n = graph.n;
+        const CSRAdjacency& csr = graph.adj_csr;
+        const std::size_t words = graph.adj_matrix.empty()
+            ? (static_cast<std::size_t>(n) + WORD_BITS - 1) / WORD_BITS
+            : graph.adj_matrix.words_per_row();
+
+        std::vector<int>& frontier = workspace.frontier;
+        std::vector<int>& next = workspace.next_frontier;
+        std::vector<Word>& frontier_bits = workspace.bits;
+        frontier_bits.resize(words);
+        frontier.assign(1, vertex);
+
+        workspace.begin();
+        workspace.visit(vertex, 0);
+        on_visit(vertex);
+
+        std::int64_t edges_frontier = csr.degree(vertex);
+        std::int64_t edges_unexplored = static_cast<std::int64_t>(csr.neighbours().size()) - edges_frontier;
+        bool bottom_up = false;
+
+        for (int level = 0; !frontier.empty(); level++) {
+            if (!bottom_up && edges_frontier > edges_unexplored / ALPHA) {
+                bottom_up = true;
+            } else if (bottom_up && static_cast<std::int64_t>(frontier.size()) < n / BETA) {
+                bottom_up = false;
+            }
+
+            next.clear();
+            std::int64_t edges_next = 0;
+            workspace.count_expanded(frontier.size());
+            workspace.note_depth(frontier.size());
+
+            if (bottom_up) {
+                std::fill(frontier_bits.begin(), frontier_bits.end(), 0);
+                for (const int u : frontier) {
+                    frontier_bits[u / WORD_BITS] |= Word{1} << (u % WORD_BITS);
+                }
+                for (int v = 0; v < n; v++) {
+                    if (workspace.visited(v)) continue;
+                    // Bottom-up probes are counted at their full degree
+                    workspace.count_edges(static_cast<std::size_t>(csr.degree(v)));
+                    if (has_parent_in(graph, v, frontier_bits)) {
+                        workspace.visit(v, level + 1);
+                        next.push_back(v);
+                        edges_next += csr.degree(v);
+                        on_visit(v);
+                    }
+                }
+            } else {
+                for (const int u : frontier) {
+                    workspace.count_edges(static_cast<std::size_t>(csr.degree(u)));
+                    for (const int neigh : csr.row(u)) {
+                        if (!workspace.visited(neigh)) {
+                            workspace.visit(neigh, level + 1);
+                            next.push_back(neigh);
+                            edges_next += csr.degree(neigh);
+                            on_visit(neigh);
+                        }
+                    }
+                }
+            }
+
+            edges_unexplored -= edges_next;
+            edges_frontier = edges_next;
+            frontier.swap(next);
+        }
+    }
+}
+
+void BFSD_do(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    TextBuffer out(std::cout);
+    out << "Vertex traversal order: \n";
+    direction_optimizing_bfs(vertex, graph, workspace, [&](const int v) { out << original_id(graph, v) << ' '; });
+    out << '\n';
+}
+
+void BFSD_do_no_print(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    direction_optimizing_bfs(vertex, graph, workspace, [](int) {});
+}
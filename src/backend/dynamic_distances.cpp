@@ -0,0 +1,137 @@
+#include "../../include/backend/dynamic_distances.h"
+
+#include <ranges>
+#include <utility>
+
+void DynamicDistances::track(const int source, std::vector<int> distances) {
+    results[source] = std::move(distances);
+}
+
+void DynamicDistances::clear() {
+    results.clear();
+}
+
+const std::vector<int>* DynamicDistances::find(const int source) const {
+    const auto it = results.find(source);
+    return it == results.end() ? nullptr : &it->second;
+}
+
+std::vector<int> DynamicDistances::tracked_sources() const {
+    std::vector<int> result;
+    for (const int source : results | std::views::keys) {
+        result.push_back(source);
+    }
+    return result;
+}
+
+long long DynamicDistances::edge_added(const Graph& graph, const int u, const int v) {
+    long long changed = 0;
+    for (auto& dist : results | std::views::values) {
+        changed += repair_insert(graph.adj_csr, dist, u, v);
+    }
+    return changed;
+}
+
+long long DynamicDistances::edge_removed(const Graph& graph, const int u, const int v) {
+    long long changed = 0;
+    for (auto& dist : results | std::views::values) {
+        changed += repair_remove(graph.adj_csr, dist, u, v);
+    }
+    return changed;
+}
+
+long long DynamicDistances::repair_insert(const CSRAdjacency& csr, std::vector<int>& dist, const int u, const int v) {
+    if (dist[u] == -1 && dist[v] == -1) return 0;
+
+    // Only vertices that get strictly closer through the new edge change; they are reached
+    // from the single improved endpoint in BFS order, so each is updated once
+    long long changed = 0;
+    queue.clear();
+    auto relax = [&](const int from, const int to) {
+        if (dist[from] != -1 && (dist[to] == -1 || dist[to] > dist[from] + 1)) {
+            dist[to] = dist[from] + 1;
+            queue.push_back(to);
+            changed++;
+        }
+    };
+
+    relax(u, v);
+    relax(v, u);
+    for (std::size_t i = 0; i < queue.size(); i++) {
+        const int x = queue[i];
+        for (const int y : csr.row(x)) {
+            relax(x, y);
+        }
+    }
+    return changed;
+}
+
+long long DynamicDistances::repair_remove(const CSRAdjacency& csr, std::vector<int>& dist, const int u, const int v) {
+    // Loops and edges between vertices of the same level lie on no shortest path
+    if (u == v || dist[u] == -1 || dist[u] == dist[v]) return 0;
+
+    if (is_affected.size() != dist.size()) is_affected.assign(dist.size(), 0);
+
+    // A vertex keeps its distance while some unaffected neighbour sits one level closer
+    auto supported = [&](const int x) {
+        for (const int y : csr.row(x)) {
+            if (!is_affected[y] && dist[y] == dist[x] - 1) return true;
+        }
+        return false;
+    };
+
+    const int child = dist[u] > dist[v] ? u : v;
+    if (supported(child)) return 0;
+
+    // Collect the affected vertices level by level: when a vertex is checked, every affected
+    // vertex of the level above has already been found
+    affected.assign(1, child);
+    is_affected[child] = 1;
+    for (std::size_t i = 0; i < affected.size(); i++) {
+        const int x = affected[i];
+        for (const int y : csr.row(x)) {
+            if (!is_affected[y] && dist[y] == dist[x] + 1 && !supported(y)) {
+                is_affected[y] = 1;
+                affected.push_back(y);
+            }
+        }
+    }
+
+    // Seed each affected vertex from its unaffected neighbours, then re-run BFS levels inside the affected set
+    previous.resize(affected.size());
+    for (std::size_t i = 0; i < affected.size(); i++) {
+        const int a = affected[i];
+        previous[i] = dist[a];
+        int best = -1;
+        for (const int y : csr.row(a)) {
+            if (!is_affected[y] && dist[y] != -1 && (best == -1 || dist[y] + 1 < best)) best = dist[y] + 1;
+        }
+        dist[a] = best;
+        if (best == -1) continue;
+        if (levels.size() <= static_cast<std::size_t>(best)) levels.resize(best + 1);
+        levels[best].push_back(a);
+    }
+
+    for (std::size_t d = 0; d < levels.size(); d++) {
+        for (std::size_t k = 0; k < levels[d].size(); k++) {
+            const int x = levels[d][k];
+            // Stale entry: x was seeded here but reached a closer level meanwhile
+            if (dist[x] != static_cast<int>(d)) continue;
+            for (const int y : csr.row(x)) {
+                if (is_affected[y] && (dist[y] == -1 || dist[y] > dist[x] + 1)) {
+                    dist[y] = dist[x] + 1;
+                    if (levels.size() <= d + 1) levels.resize(d + 2);
+                    levels[d + 1].push_back(y);
+                }
+            }
+        }
+        levels[d].clear();
+    }
+
+    long long changed = 0;
+    for (std::size_t i = 0; i < affected.size(); i++) {
+        if (dist[affected[i]] != previous[i]) changed++;
+        is_affected[affected[i]] = 0;
+    }
+    return changed;
+}
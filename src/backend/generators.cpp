@@ -0,0 +1,398 @@
+#include "../../include/backend/generators.h"
+#include "../../include/backend/jobs.h"
+#include "../../include/backend/parallel.h"
+#include "../../include/backend/philox.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <climits>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+    // Philox streams, one per model
+    constexpr std::uint32_t RMAT_STREAM = 3;
+    constexpr std::uint32_t BA_STREAM = 4;
+
+    // R-MAT draws outside [0, n) are redrawn this many times before being folded into range
+    constexpr std::uint32_t RMAT_ATTEMPTS = 64;
+
+    // Edges drawn per work item
+    constexpr std::int64_t EDGE_BLOCK = 4096;
+
+    // graph_from_edges sorts entries in buckets of 2^BUCKET_BITS consecutive vertices
+    constexpr int BUCKET_BITS = 14;
+
+    using Edge = std::pair<int, int>;
+
+    GraphModel parse_model(const std::string& name) {
+        if (name == "er") return GraphModel::ER;
+        if (name == "rmat") return GraphModel::RMAT;
+        if (name == "ba") return GraphModel::BA;
+        if (name == "grid") return GraphModel::Grid;
+        throw std::invalid_argument("unknown model: " + name);
+    }
+
+    // Run draw(e) for every edge index in [0, count) on all hardware threads, reporting finished blocks to the job
+    template <class Draw>
+    void draw_edges(const std::int64_t count, JobControl* job, Draw&& draw) {
+        if (job != nullptr) job->expect(count);
+        const auto blocks = static_cast<int>((count + EDGE_BLOCK - 1) / EDGE_BLOCK);
+
+        parallel_for(0, blocks, hardware_threads(), [&](const int block, int) {
+            if (job != nullptr && job->cancel_requested()) return;
+            const std::int64_t first = static_cast<std::int64_t>(block) * EDGE_BLOCK;
+            const std::int64_t last = std::min(first + EDGE_BLOCK, count);
+            for (std::int64_t e = first; e < last; e++) {
+                draw(e);
+            }
+            if (job != nullptr) job->advance(last - first);
+        });
+        job_checkpoint(job);
+    }
+
+    // Recursive-matrix edges: every level picks one quadrant of the adjacency matrix with probabilities a, b, c, d
+    std::vector<Edge> rmat_edges(const GeneratorOptions& options, const Philox4x32& rng, JobControl* job) {
+        const int n = options.n;
+        const int scale = std::bit_width(static_cast<unsigned int>(n - 1));
+        const double ab = options.a + options.b;
+        const double abc = ab + options.c;
+        const std::int64_t count = static_cast<std::int64_t>(n) * options.edge_factor;
+        std::vector<Edge> edges(count);
+
+        draw_edges(count, job, [&](const std::int64_t e) {
+            const auto low = static_cast<std::uint32_t>(e);
+            const auto high = static_cast<std::uint32_t>(e >> 32);
+            int u = 0;
+            int v = 0;
+            for (std::uint32_t attempt = 0; attempt < RMAT_ATTEMPTS; attempt++) {
+                u = 0;
+                v = 0;
+                Philox4x32::Block block{};
+                for (int level = 0; level < scale; level++) {
+                    // One Philox block covers four levels
+                    if (level % 4 == 0) block = rng({low, high, attempt * 8 + static_cast<std::uint32_t>(level / 4), RMAT_STREAM});
+                    const double r = static_cast<double>(block[level % 4]) * 0x1.0p-32;
+                    const int bit = 1 << (scale - 1 - level);
+                    if (r >= ab) u |= bit;
+                    if ((r >= options.a && r < ab) || r >= abc) v |= bit;
+                }
+                if (u < n && v < n) break;
+            }
+            edges[e] = {u % n, v % n};
+        });
+        return edges;
+    }
+
+    /**
+     * Preferential attachment in the Bollobás–Riordan form: edge e belongs to vertex e / attach, and its
+     * target is copied from a uniformly chosen earlier endpoint slot, which picks vertices in proportion
+     * to their degree. A copied target is itself a pure function of its edge, so every edge is drawn
+     * independently of the others.
+     */
+    std::vector<Edge> ba_edges(const GeneratorOptions& options, const Philox4x32& rng, JobControl* job) {
+        const std::int64_t attach = options.attach;
+        const std::int64_t count = static_cast<std::int64_t>(options.n) * attach;
+        std::vector<Edge> edges(count);
+
+        // Slot 2e holds the vertex of edge e, slot 2e + 1 its target
+        auto target = [&](std::int64_t e) {
+            while (e > 0) {
+                const Philox4x32::Block block = rng({static_cast<std::uint32_t>(e), static_cast<std::uint32_t>(e >> 32), 0, BA_STREAM});
+                const std::uint64_t bits = static_cast<std::uint64_t>(block[0]) << 32 | block[1];
+                const auto slot = static_cast<std::int64_t>(bits % static_cast<std::uint64_t>(2 * e));
+                if (slot % 2 == 0) return static_cast<int>(slot / 2 / attach);
+                e = slot / 2;
+            }
+            return 0;
+        };
+
+        draw_edges(count, job, [&](const std::int64_t e) {
+            edges[e] = {static_cast<int>(e / attach), target(e)};
+        });
+        return edges;
+    }
+
+    // 4-neighbour rows x cols lattice; edge 2v goes right of v, edge 2v + 1 down (self-loops on the border)
+    std::vector<Edge> grid_edges(const GeneratorOptions& options, JobControl* job) {
+        const int cols = options.cols;
+        const std::int64_t count = 2 * static_cast<std::int64_t>(options.n);
+        std::vector<Edge> edges(count);
+
+        draw_edges(count, job, [&](const std::int64_t e) {
+            const auto v = static_cast<int>(e / 2);
+            const bool right = e % 2 == 0;
+            if (right) {
+                edges[e] = {v, v % cols + 1 < cols ? v + 1 : v};
+            } else {
+                edges[e] = {v, v / cols + 1 < options.rows ? v + cols : v};
+            }
+        });
+        return edges;
+    }
+
+    // Whether the adjacency matrix of n vertices stays within GENERATED_MATRIX_LIMIT
+    bool matrix_fits(const int n) {
+        const std::size_t matrix_bytes = static_cast<std::size_t>(n) * BitMatrix::stride_for(n) * sizeof(BitMatrix::word_type);
+        return matrix_bytes <= GENERATED_MATRIX_LIMIT;
+    }
+}
+
+const char* model_name(const GraphModel model) {
+    switch (model) {
+        case GraphModel::ER: return "er";
+        case GraphModel::RMAT: return "rmat";
+        case GraphModel::BA: return "ba";
+        case GraphModel::Grid: return "grid";
+    }
+    return "?";
+}
+
+GeneratorOptions parse_generator_options(const std::vector<std::string>& args) {
+    GeneratorOptions options;
+    std::vector<std::string> positional;
+    for (std::size_t i = 0; i < args.size(); i++) {
+        const std::string& key = args[i];
+        if (!key.starts_with("--")) {
+            positional.push_back(key);
+            continue;
+        }
+        if (i + 1 >= args.size()) throw std::invalid_argument("missing value for " + key);
+        const std::string& value = args[++i];
+
+        if (key == "--model") {
+            options.model = parse_model(value);
+        } else if (key == "--edge-factor") {
+            options.edge_factor = std::stoi(value);
+        } else if (key == "--a") {
+            options.a = std::stod(value);
+        } else if (key == "--b") {
+            options.b = std::stod(value);
+        } else if (key == "--c") {
+            options.c = std::stod(value);
+        } else if (key == "--attach") {
+            options.attach = std::stoi(value);
+        } else if (key == "--weights") {
+            const long long max_weight = std::stoll(value);
+            if (max_weight < 1 || max_weight > INT_MAX) throw std::invalid_argument("weights must be between 1 and " + std::to_string(INT_MAX));
+            options.max_weight = static_cast<std::uint32_t>(max_weight);
+        } else if (key == "--seed") {
+            options.seed = static_cast<unsigned int>(std::stoul(value));
+        } else {
+            throw std::invalid_argument("unknown option " + key);
+        }
+    }
+
+    const std::size_t expected = options.model == GraphModel::ER ? 3 : options.model == GraphModel::Grid ? 2 : 1;
+    if (positional.size() > expected) throw std::invalid_argument("unexpected argument " + positional[expected]);
+    if (options.model != GraphModel::ER && positional.empty()) {
+        throw std::invalid_argument(options.model == GraphModel::Grid ? "expected <rows> <cols>" : "expected <n>");
+    }
+
+    switch (options.model) {
+        case GraphModel::ER:
+            // Validated by the caller, keeping the defaults of plain create
+            if (!positional.empty()) options.n = std::stoi(positional[0]);
+            if (positional.size() > 1) options.edge_prob = std::stod(positional[1]);
+            if (positional.size() > 2) options.loop_prob = std::stod(positional[2]);
+            break;
+        case GraphModel::RMAT:
+            options.n = std::stoi(positional[0]);
+            if (options.edge_factor < 1) throw std::invalid_argument("edge factor must be positive");
+            if (options.a < 0 || options.b < 0 || options.c < 0 || options.a + options.b + options.c > 1) {
+                throw std::invalid_argument("quadrant probabilities must be non-negative with a + b + c <= 1");
+            }
+            break;
+        case GraphModel::BA:
+            options.n = std::stoi(positional[0]);
+            if (options.attach < 1) throw std::invalid_argument("attach must be positive");
+            break;
+        case GraphModel::Grid: {
+            options.rows = std::stoi(positional[0]);
+            options.cols = positional.size() > 1 ? std::stoi(positional[1]) : options.rows;
+            if (options.rows < 1 || options.cols < 1) throw std::invalid_argument("grid sides must be positive");
+            const long long vertices = static_cast<long long>(options.rows) * options.cols;
+            if (vertices > INT_MAX) throw std::invalid_argument("grid is too large");
+            options.n = static_cast<int>(vertices);
+            break;
+        }
+    }
+    return options;
+}
+
+Graph graph_from_edges(const int n, const std::span<const std::pair<int, int>> edges, const bool keep_loops, JobControl* job) {
+    const int threads = hardware_threads();
+    Graph graph;
+    graph.n = n;
+
+    // Entries are first partitioned into buckets of consecutive vertices, few enough for the bucket's counters
+    // to stay in cache, then counting-sorted bucket by bucket; no pass shares counters between threads
+    const int shift = std::max(0, static_cast<int>(std::bit_width(static_cast<unsigned int>(n - 1))) - BUCKET_BITS);
+    const int buckets = ((n - 1) >> shift) + 1;
+    const int stripes = static_cast<int>(std::min<std::size_t>(4 * static_cast<std::size_t>(threads), edges.size() / EDGE_BLOCK + 1));
+
+    // Run fn(from, to) for every adjacency entry of a stripe of edges: both directions, a loop once
+    auto for_each_entry = [&](const int stripe, auto&& fn) {
+        const std::size_t first = edges.size() * stripe / stripes;
+        const std::size_t last = edges.size() * (stripe + 1) / stripes;
+        for (std::size_t e = first; e < last; e++) {
+            const auto [u, v] = edges[e];
+            if (u != v || keep_loops) fn(u, v);
+            if (u != v) fn(v, u);
+        }
+    };
+
+    // positions[stripe * buckets + b]: where the stripe's entries of bucket b go
+    std::vector<std::int64_t> positions(static_cast<std::size_t>(stripes) * buckets, 0);
+    parallel_for(0, stripes, threads, [&](const int stripe, int) {
+        std::int64_t* count = positions.data() + static_cast<std::size_t>(stripe) * buckets;
+        for_each_entry(stripe, [&](const int from, int) { count[from >> shift]++; });
+    });
+    std::vector<std::int64_t> bucket_begin(static_cast<std::size_t>(buckets) + 1, 0);
+    std::int64_t entries = 0;
+    for (int b = 0; b < buckets; b++) {
+        bucket_begin[b] = entries;
+        for (int stripe = 0; stripe < stripes; stripe++) {
+            std::int64_t& position = positions[static_cast<std::size_t>(stripe) * buckets + b];
+            const std::int64_t count = position;
+            position = entries;
+            entries += count;
+        }
+    }
+    bucket_begin[buckets] = entries;
+
+    std::vector<std::pair<int, int>> partitioned(entries);
+    parallel_for(0, stripes, threads, [&](const int stripe, int) {
+        std::int64_t* position = positions.data() + static_cast<std::size_t>(stripe) * buckets;
+        for_each_entry(stripe, [&](const int from, const int to) { partitioned[position[from >> shift]++] = {from, to}; });
+    });
+    positions = std::vector<std::int64_t>();
+    job_checkpoint(job);
+
+    graph.adj_list.resize(n);
+    parallel_for(0, buckets, threads, [&](const int b, int) {
+        const int first_vertex = b << shift;
+        const int width = std::min(n - first_vertex, 1 << shift);
+        const auto first = partitioned.begin() + bucket_begin[b];
+        const auto last = partitioned.begin() + bucket_begin[b + 1];
+
+        std::vector<std::int64_t> offsets(static_cast<std::size_t>(width) + 1, 0);
+        for (auto it = first; it != last; ++it) offsets[it->first - first_vertex + 1]++;
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        std::vector<int> rows(static_cast<std::size_t>(last - first));
+        std::vector<std::int64_t> fill(offsets.begin(), offsets.end() - 1);
+        for (auto it = first; it != last; ++it) rows[fill[it->first - first_vertex]++] = it->second;
+
+        for (int i = 0; i < width; i++) {
+            const auto row_first = rows.begin() + offsets[i];
+            const auto row_last = rows.begin() + offsets[i + 1];
+            std::sort(row_first, row_last);
+            graph.adj_list[first_vertex + i].assign(row_first, std::unique(row_first, row_last));
+        }
+    });
+    partitioned = std::vector<std::pair<int, int>>();
+    graph.adj_csr = build_csr(graph.adj_list);
+
+    if (matrix_fits(n)) {
+        graph.adj_matrix.reset(n);
+        // Every thread sets bits in its own rows only
+        parallel_for(0, n, threads, [&](const int v, int) {
+            for (const int u : graph.adj_list[v]) graph.adj_matrix.set(v, u);
+        }, 64);
+    }
+    return graph;
+}
+
+void assign_edge_weights(Graph& graph, const std::span<const std::pair<int, int>> edges, const std::span<const std::uint32_t> weights) {
+    const CSRAdjacency& csr = graph.adj_csr;
+    const int threads = hardware_threads();
+    graph.weights.assign(csr.neighbours().size(), UINT32_MAX);
+
+    // Repeats of an edge may sit in different stripes, so entries are lowered with an atomic minimum
+    auto lower = [&](const int from, const int to, const std::uint32_t weight) {
+        const auto row = csr.row(from);
+        const auto position = csr.offsets()[from] + (std::lower_bound(row.begin(), row.end(), to) - row.begin());
+        std::atomic_ref<std::uint32_t> entry(graph.weights[position]);
+        std::uint32_t current = entry.load(std::memory_order_relaxed);
+        while (weight < current && !entry.compare_exchange_weak(current, weight, std::memory_order_relaxed)) {}
+    };
+
+    const int stripes = static_cast<int>(std::min<std::size_t>(4 * static_cast<std::size_t>(threads), edges.size() / EDGE_BLOCK + 1));
+    parallel_for(0, stripes, threads, [&](const int stripe, int) {
+        const std::size_t last = edges.size() * (stripe + 1) / stripes;
+        for (std::size_t e = edges.size() * stripe / stripes; e < last; e++) {
+            const auto [u, v] = edges[e];
+            lower(u, v, weights[e]);
+            if (u != v) lower(v, u, weights[e]);
+        }
+    });
+}
+
+Graph generate_graph(const GeneratorOptions& options, JobControl* job) {
+    // Resolved once, so the edges and their weights come from the same seed
+    const unsigned int seed = generator_seed(options.seed);
+    Graph graph;
+    if (options.model == GraphModel::ER) {
+        graph = create_graph(options.n, options.edge_prob, options.loop_prob, seed, job, matrix_fits(options.n));
+    } else {
+        if (options.n <= 0) throw std::invalid_argument("graph size must be positive");
+
+        const Philox4x32 rng(seed);
+        std::vector<Edge> edges;
+        switch (options.model) {
+            case GraphModel::RMAT: edges = rmat_edges(options, rng, job); break;
+            case GraphModel::BA: edges = ba_edges(options, rng, job); break;
+            case GraphModel::Grid: edges = grid_edges(options, job); break;
+            case GraphModel::ER: break;
+        }
+        graph = graph_from_edges(options.n, edges, false, job);
+    }
+
+    if (options.max_weight > 0) {
+        job_checkpoint(job);
+        assign_random_weights(graph, options.max_weight, seed);
+    }
+    return graph;
+}
+
+void print_generated(const Graph& graph, const GeneratorOptions& options, std::ostream& output) {
+    const CSRAdjacency& csr = graph.adj_csr;
+    int max_degree = 0;
+    for (int v = 0; v < graph.n; v++) {
+        max_degree = std::max(max_degree, csr.degree(v));
+    }
+    const auto entries = static_cast<long long>(csr.neighbours().size());
+
+    output << "Created " << model_name(options.model) << " graph with " << graph.n << " vertices and "
+           << edge_count(graph) << " edges" << std::endl;
+    switch (options.model) {
+        case GraphModel::ER:
+            output << "  Edge probability: " << options.edge_prob << ", Loop probability: " << options.loop_prob;
+            break;
+        case GraphModel::RMAT:
+            output << "  Edge factor: " << options.edge_factor << ", a: " << options.a << ", b: " << options.b
+                   << ", c: " << options.c;
+            break;
+        case GraphModel::BA:
+            output << "  Attach: " << options.attach;
+            break;
+        case GraphModel::Grid:
+            output << "  Grid: " << options.rows << " x " << options.cols;
+            break;
+    }
+    // The grid has no random decisions
+    if (options.model != GraphModel::Grid) output << ", seed: " << options.seed;
+    output << std::endl;
+
+    const double average = graph.n > 0 ? static_cast<double>(entries) / graph.n : 0.0;
+    output << "  Average degree: " << average << ", max degree: " << max_degree << std::endl;
+    if (is_weighted(graph)) output << "  Edge weights: 1.." << options.max_weight << std::endl;
+    if (graph.adj_matrix.empty()) {
+        output << "  Adjacency matrix skipped: it would take more than "
+               << (GENERATED_MATRIX_LIMIT >> 20) << " MiB" << std::endl;
+    }
+}
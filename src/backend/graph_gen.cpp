@@ -1,348 +1,619 @@
 // Created by IWOFLEUR on 19.10.2025
 
 #include "../../include/backend/graph_gen.h"
-
+#include "../../include/backend/all_pairs.h"
+#include "../../include/backend/dobfs.h"
+#include "../../include/backend/jobs.h"
+#include "../../include/backend/pbfs.h"
+#include "../../include/backend/philox.h"
+#include "../../include/backend/shortest_paths.h"
+#include "../../include/backend/simd_scan.h"
+#include "../../include/backend/text_buffer.h"
+#include "../../include/backend/traversal_engine.h"
+#include "../../include/backend/traversal_stats.h"
+
+#include <algorithm>
+#include <atomic>
 #include <chrono>
-#include <queue>
-#include <stack>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    // Philox streams, one per kind of random decision
+    constexpr std::uint32_t EDGE_STREAM = 0;
+    constexpr std::uint32_t LOOP_STREAM = 1;
+    constexpr std::uint32_t SKIP_STREAM = 2;
+    constexpr std::uint32_t WEIGHT_STREAM = 5;
+
+    // Below this edge probability rows are generated by geometric skip sampling in O(degree)
+    constexpr double SKIP_SAMPLING_PROB = 0.3;
+
+    // Bernoulli trial with probability p against a full 64-bit threshold
+    struct Bernoulli {
+        std::uint64_t threshold;
+        bool always;
+
+        explicit Bernoulli(const double p)
+            : threshold(p >= 1.0 ? 0 : static_cast<std::uint64_t>(std::ldexp(std::max(p, 0.0), 64))),
+              always(p >= 1.0) {}
+
+        bool operator()(const std::uint64_t bits) const { return always || bits < threshold; }
+    };
 
-Graph create_graph(const int n, const double edgeProb, const double loopProb, const unsigned int seed) {
-    Graph graph;
-    graph.n = n;
+    // Every row draws all of its n pairs itself, so rows are independent and need no transpose
+    void generate_dense(Graph& graph, const Philox4x32& rng, const double edgeProb, const double loopProb, const int threads,
+                        JobControl* job) {
+        const int n = graph.n;
+        const bool with_matrix = !graph.adj_matrix.empty();
+        const Bernoulli edge(edgeProb);
+        const Bernoulli loop(loopProb);
+        std::vector<std::vector<int>> rows(threads);
+
+        parallel_for(0, n, threads, [&](const int v, const int thread_id) {
+            if (job != nullptr && job->cancel_requested()) return;
+            std::vector<int>& row = rows[thread_id];
+            row.clear();
+            for (int j = 0; j < n; j++) {
+                const bool present = j == v
+                    ? loop(rng.bits(v, v, LOOP_STREAM))
+                    : edge(rng.bits(std::min(v, j), std::max(v, j), EDGE_STREAM));
+                if (present) {
+                    if (with_matrix) graph.adj_matrix.set(v, j);
+                    row.push_back(j);
+                }
+            }
+            graph.adj_list[v].assign(row.begin(), row.end());
+            if (job != nullptr) job->advance();
+        }, 16);
+    }
 
-    // Matrix memory allocating
-    graph.adj_matrix = new int*[n];
-    for (int i = 0; i < n; i++) {
-        graph.adj_matrix[i] = new int[n];
-        for (int j = 0; j < n; j++) {
-            graph.adj_matrix[i][j] = 0;
+    // Rows jump between neighbours with geometric gaps, then the upper triangle is mirrored in O(m)
+    void generate_sparse(Graph& graph, const Philox4x32& rng, const double edgeProb, const double loopProb, const int threads,
+                         JobControl* job) {
+        const int n = graph.n;
+        const Bernoulli loop(loopProb);
+        const double log_q = std::log1p(-edgeProb);
+        std::vector<std::vector<int>> upper(n);
+        std::vector<char> loops(n, 0);
+
+        parallel_for(0, n, threads, [&](const int i, int) {
+            if (job != nullptr) {
+                if (job->cancel_requested()) return;
+                job->advance();
+            }
+            loops[i] = loop(rng.bits(i, i, LOOP_STREAM));
+            if (edgeProb <= 0) return;
+            int j = i;
+            for (std::uint32_t k = 0; ; k++) {
+                const double skip = std::floor(std::log(rng.uniform(i, k, SKIP_STREAM)) / log_q);
+                if (skip >= static_cast<double>(n - j - 1)) break;
+                j += 1 + static_cast<int>(skip);
+                upper[i].push_back(j);
+            }
+        }, 64);
+        job_checkpoint(job);
+
+        std::vector<std::size_t> degree(n, 0);
+        for (int i = 0; i < n; i++) {
+            degree[i] += loops[i] + upper[i].size();
+            for (const int j : upper[i]) degree[j]++;
+        }
+        for (int i = 0; i < n; i++) {
+            graph.adj_list[i].reserve(degree[i]);
+        }
+
+        // Rows in ascending order keep every list sorted: lower neighbours, loop, upper neighbours
+        const bool with_matrix = !graph.adj_matrix.empty();
+        for (int i = 0; i < n; i++) {
+            if (loops[i]) {
+                if (with_matrix) graph.adj_matrix.set(i, i);
+                graph.adj_list[i].push_back(i);
+            }
+            for (const int j : upper[i]) {
+                if (with_matrix) {
+                    graph.adj_matrix.set(i, j);
+                    graph.adj_matrix.set(j, i);
+                }
+                graph.adj_list[i].push_back(j);
+                graph.adj_list[j].push_back(i);
+            }
         }
     }
+}
+
+unsigned int generator_seed(const unsigned int seed) {
+    if (seed != 0) return seed;
+    // Background jobs may create graphs concurrently
+    static std::atomic<unsigned int> counter = 0;
+    const auto now = std::chrono::high_resolution_clock::now();
+    const auto nanos = std::chrono::time_point_cast<std::chrono::nanoseconds>(now).time_since_epoch().count();
+    return static_cast<unsigned int>(nanos) + counter++;
+}
+
+Graph create_graph(const int n, const double edgeProb, const double loopProb, const unsigned int seed, JobControl* job,
+                   const bool with_matrix) {
+    Graph graph;
+    graph.n = n;
+
+    // Matrix memory allocating (one zeroed contiguous block); the generators skip it while it stays empty
+    if (with_matrix) graph.adj_matrix.reset(n);
 
     // List initialization
     graph.adj_list.resize(n);
 
-    static unsigned int counter = 0;
-    const auto now = std::chrono::high_resolution_clock::now();
-    const auto nanos = std::chrono::time_point_cast<std::chrono::nanoseconds>(now).time_since_epoch().count();
-    unsigned int state = seed == 0 ? static_cast<unsigned int>(nanos) + counter++ : seed;
+    const Philox4x32 rng(generator_seed(seed));
+    const int threads = hardware_threads();
+    if (job != nullptr) job->expect(n);
 
-    for (int i = 0; i < n; i++) {
-        for (int j = i; j < n; j++) {
-            state = (state * 1664525 + 1013904223) & 0x7fffffff;
-            const int rand_value = static_cast<int>(state) % 100;
+    if (edgeProb < SKIP_SAMPLING_PROB) {
+        generate_sparse(graph, rng, edgeProb, loopProb, threads, job);
+    } else {
+        generate_dense(graph, rng, edgeProb, loopProb, threads, job);
+    }
+    job_checkpoint(job);
 
-            if (i == j) {
-                if (rand_value < static_cast<int>(loopProb * 100)) {
-                    graph.adj_matrix[i][j] = 1;
-                    graph.adj_list[i].push_back(i);
-                }
-            } else {
-                if (rand_value < static_cast<int>(edgeProb * 100)) {
-                    graph.adj_matrix[i][j] = graph.adj_matrix[j][i] = 1;
-                    graph.adj_list[i].push_back(j);
-                    graph.adj_list[j].push_back(i);
-                }
-            }
+    graph.adj_csr = build_csr(graph.adj_list);
+
+    return graph;
+}
+
+void assign_random_weights(Graph& graph, const std::uint32_t max_weight, const unsigned int seed) {
+    const CSRAdjacency& csr = graph.adj_csr;
+    const Philox4x32 rng(generator_seed(seed));
+    graph.weights.resize(csr.neighbours().size());
+
+    parallel_for(0, graph.n, hardware_threads(), [&](const int v, int) {
+        const auto row = csr.row(v);
+        std::uint32_t* weights = graph.weights.data() + csr.offsets()[v];
+        const int from = original_id(graph, v);
+        for (std::size_t i = 0; i < row.size(); i++) {
+            const int to = original_id(graph, row[i]);
+            const std::uint64_t bits = rng.bits(std::min(from, to), std::max(from, to), WEIGHT_STREAM);
+            weights[i] = 1 + static_cast<std::uint32_t>(bits % max_weight);
         }
+    }, 64);
+}
+
+CSRAdjacency build_csr(const std::vector<std::vector<int>> &list) {
+    std::size_t entries = 0;
+    for (const auto& row : list) {
+        entries += row.size();
     }
 
-    return graph;
+    std::vector<std::int64_t> offsets(list.size() + 1);
+    std::vector<int> neighbours;
+    neighbours.reserve(entries);
+    for (std::size_t v = 0; v < list.size(); v++) {
+        offsets[v] = static_cast<std::int64_t>(neighbours.size());
+        neighbours.insert(neighbours.end(), list[v].begin(), list[v].end());
+    }
+    offsets[list.size()] = static_cast<std::int64_t>(neighbours.size());
+
+    return {std::move(offsets), std::move(neighbours)};
 }
 
-void print_matrix(int **matrix, const int rows, const int cols, const char *name) {
-    if (!matrix || rows <= 0 || cols <= 0) {
+void print_matrix(const BitMatrix& matrix, const char *name) {
+    const int rows = matrix.size();
+    const int cols = matrix.size();
+    if (matrix.empty() || rows <= 0) {
         std::cout << "Invalid matrix parameters" << std::endl;
         return;
     }
 
-    std::cout << name << ":" << std::endl;
+    TextBuffer out(std::cout);
+    out << name << ":\n";
 
-    // Calculate maximum width needed for numbers
-    int max_num_width = 1;
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            if (const int num_width = static_cast<int>(std::to_string(matrix[i][j]).length()); num_width > max_num_width) {
-                max_num_width = num_width;
-            }
-        }
-    }
-
-    // Calculate width for row indices
-    const int row_index_width = static_cast<int>(std::to_string(rows - 1).length());
-    max_num_width = std::max(max_num_width, 2);
+    // Cells are single bits, so the column width only depends on the widest column index
+    const int row_index_width = TextBuffer::width_of(rows - 1);
+    const int cell_width = std::max(2, TextBuffer::width_of(cols - 1)) + 1;
 
     // Print column headers with dynamic spacing
-    std::cout << std::setw(row_index_width + 2) << " ";
+    out.repeat(' ', row_index_width + 2);
     for (int j = 0; j < cols; j++) {
-        std::cout << std::setw(max_num_width + 1) << j;
+        out.right(j, cell_width);
     }
-    std::cout << std::endl;
+    out << '\n';
 
     // Print separator line
-    std::cout << std::setw(row_index_width + 2) << " " << "+";
-    for (int j = 0; j < cols; j++) {
-        std::cout << std::string(max_num_width + 1, '-');
-    }
-    std::cout << std::endl;
+    out.repeat(' ', row_index_width + 2) << '+';
+    out.repeat('-', static_cast<std::size_t>(cols) * cell_width) << '\n';
 
     // Print matrix rows with borders
     for (int i = 0; i < rows; i++) {
-        std::cout << std::setw(row_index_width) << i << " |";
+        out.right(i, row_index_width) << " |";
         for (int j = 0; j < cols; j++) {
-            std::cout << std::setw(max_num_width + 1) << matrix[i][j];
+            out.repeat(' ', cell_width - 1) << (matrix.test(i, j) ? '1' : '0');
         }
-        std::cout << std::endl;
+        out << '\n';
     }
 }
 
-void delete_graph(Graph& graph, const int n) {
-    for (int i = 0; i < n; i++) {
-        delete[] graph.adj_matrix[i];
-    }
-    delete[] graph.adj_matrix;
-    graph.adj_matrix = nullptr;
+void delete_graph(Graph& graph) {
+    graph.adj_matrix.reset();
     graph.n = 0;
     graph.adj_list.resize(0);
+    graph.adj_csr = CSRAdjacency();
+    graph.weights = std::vector<std::uint32_t>();
+    graph.version = next_graph_version();
+}
+
+namespace {
+    void check_vertices(const Graph& graph, const int u, const int v) {
+        if (u < 0 || u >= graph.n || v < 0 || v >= graph.n) {
+            throw std::out_of_range("vertex out of range [0, " + std::to_string(graph.n) + ")");
+        }
+    }
+
+    void insert_sorted(std::vector<int>& row, const int u) {
+        row.insert(std::lower_bound(row.begin(), row.end(), u), u);
+    }
+
+    void erase_sorted(std::vector<int>& row, const int u) {
+        const auto found = std::lower_bound(row.begin(), row.end(), u);
+        if (found != row.end() && *found == u) row.erase(found);
+    }
+
+    // Index of u in the CSR arrays if it were in the sorted row of v
+    std::int64_t csr_position(const CSRAdjacency& csr, const int v, const int u) {
+        const auto row = csr.row(v);
+        return csr.offsets()[v] + (std::lower_bound(row.begin(), row.end(), u) - row.begin());
+    }
+}
+
+std::uint64_t next_graph_version() {
+    static std::atomic<std::uint64_t> last{0};
+    return last.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+bool has_edge(const Graph& graph, const int u, const int v) {
+    check_vertices(graph, u, v);
+    if (!graph.adj_matrix.empty()) return graph.adj_matrix.test(u, v);
+    const auto row = graph.adj_csr.row(u);
+    return std::binary_search(row.begin(), row.end(), v);
+}
+
+long long edge_count(const Graph& graph) {
+    const CSRAdjacency& csr = graph.adj_csr;
+    long long loops = 0;
+    for (int v = 0; v < graph.n; v++) {
+        const auto row = csr.row(v);
+        if (std::binary_search(row.begin(), row.end(), v)) loops++;
+    }
+    return (static_cast<long long>(csr.neighbours().size()) + loops) / 2;
+}
+
+bool add_edge(Graph& graph, const int u, const int v, const std::uint32_t weight) {
+    if (has_edge(graph, u, v)) return false;
+
+    const bool with_list = has_representation(graph, Representation::List);
+    const bool weighted = is_weighted(graph);
+    // A loop appears once in its row, any other edge in both rows
+    for (const auto& [from, to] : {std::pair{u, v}, std::pair{v, u}}) {
+        if (!graph.adj_matrix.empty()) graph.adj_matrix.set(from, to);
+        if (with_list) insert_sorted(graph.adj_list[from], to);
+        if (weighted) graph.weights.insert(graph.weights.begin() + csr_position(graph.adj_csr, from, to), weight);
+        graph.adj_csr.insert(from, to);
+        if (u == v) break;
+    }
+    graph.version = next_graph_version();
+    return true;
+}
+
+bool remove_edge(Graph& graph, const int u, const int v) {
+    if (!has_edge(graph, u, v)) return false;
+
+    const bool with_list = has_representation(graph, Representation::List);
+    const bool weighted = is_weighted(graph);
+    for (const auto& [from, to] : {std::pair{u, v}, std::pair{v, u}}) {
+        if (!graph.adj_matrix.empty()) graph.adj_matrix.clear(from, to);
+        if (with_list) erase_sorted(graph.adj_list[from], to);
+        if (weighted) graph.weights.erase(graph.weights.begin() + csr_position(graph.adj_csr, from, to));
+        graph.adj_csr.erase(from, to);
+        if (u == v) break;
+    }
+    graph.version = next_graph_version();
+    return true;
 }
 
 void print_list(const std::vector<std::vector<int> > &list, const char* name) {
-    std::cout << name << ":" << std::endl;
-    for (int i = 0; i < list.size(); i++) {
-        std::cout << i << ": ";
+    TextBuffer out(std::cout);
+    out << name << ":\n";
+    for (std::size_t i = 0; i < list.size(); i++) {
+        out << i << ": ";
         for (const int neigh : list[i]) {
-            std::cout << neigh << " ";
+            out << neigh << ' ';
         }
-        std::cout << std::endl;
+        out << '\n';
+    }
+}
+
+void print_csr(const CSRAdjacency &csr, const char *name) {
+    TextBuffer out(std::cout);
+    out << name << ":\n";
+    out << "offsets: ";
+    for (const std::int64_t offset : csr.offsets()) {
+        out << offset << ' ';
     }
+    out << '\n';
+    out << "neighbours: ";
+    for (const int neigh : csr.neighbours()) {
+        out << neigh << ' ';
+    }
+    out << '\n';
 }
 
-long long prep(const Graph& graph, const int vertex, const bool representation, const bool method) {
+void print_distances(const Graph& graph, const std::span<const int> distances, std::ostream& output) {
+    TextBuffer out(output);
+    out << "Distances vector:\n";
+    for (std::size_t i = 0; i < distances.size(); i++) {
+        out << distances[current_id(graph, static_cast<int>(i))] << ' ';
+    }
+    out << '\n';
+}
+
+long long prep(const Graph& graph, const int vertex, const Representation representation, const Method method,
+               std::vector<int>* distances) {
     const int n = graph.n;
-    std::vector distances(n, -1);
+    TraversalWorkspace workspace(n);
+    PerfCounters counters;
 
     const auto start = std::chrono::high_resolution_clock::now();
-    switch (representation) {
-        case false:
-            method == false ? BFSD(vertex, graph, distances) : DFSD(vertex, graph, distances);
+    // Direction-optimizing BFS always combines CSR and matrix
+    if (method == Method::DOBFS) {
+        BFSD_do(vertex, graph, workspace);
+    } else if (method == Method::PBFS) {
+        BFSD_par(vertex, graph, representation, workspace);
+    } else switch (representation) {
+        case Representation::Matrix:
+            method == Method::BFS ? BFSD(vertex, graph, workspace) : DFSD(vertex, graph, workspace);
             break;
-        case true:
-            method == false ? BFSD_list(vertex, graph, distances) : DFSD_list(vertex, graph, distances);
+        case Representation::List:
+            method == Method::BFS ? BFSD_list(vertex, graph, workspace) : DFSD_list(vertex, graph, workspace);
+            break;
+        case Representation::CSR:
+            method == Method::BFS ? BFSD_csr(vertex, graph, workspace) : DFSD_csr(vertex, graph, workspace);
             break;
-    }
-
-    std::cout << "Distances vector:" << std::endl;
-    for (int i = 0; i < n; i++) {
-        std::cout << distances[i] << " ";
     }
     const auto end = std::chrono::high_resolution_clock::now();
+    counters.stop(workspace.stats);
 
-    std::cout << std::endl;
+    stats_begin("traversal from vertex " + std::to_string(original_id(graph, vertex)));
+    stats_record(search_label(representation, method), workspace.stats);
+
+    std::vector<int> result(n);
+    workspace.export_all(result);
+    print_distances(graph, result);
+    if (distances != nullptr) *distances = std::move(result);
 
     return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
 }
 
-
-void BFSD(const int vertex, const Graph &graph, std::vector<int> &dist) {
-    std::queue<int> q;
-    q.push(vertex);
-    dist[vertex] = 0;
-    std::cout << "Vertex traversal order: " << std::endl;
-
-    while (!q.empty()) {
-        const int current_vertex = q.front();
-        q.pop();
-        std::cout << current_vertex << " ";
-        for (int i = 1; i < graph.n; i++) {
-            if (graph.adj_matrix[current_vertex][i] == 1 && dist[i] == -1) {
-                q.push(i);
-                dist[i] = dist[current_vertex] + 1;
-            }
-        }
+const char* representation_name(const Representation representation) {
+    switch (representation) {
+        case Representation::Matrix: return "matrix";
+        case Representation::List: return "list";
+        case Representation::CSR: return "csr";
     }
+    return "?";
+}
 
-    std::cout << std::endl;
+const char* method_name(const Method method) {
+    switch (method) {
+        case Method::BFS: return "bfs";
+        case Method::DFS: return "dfs";
+        case Method::DOBFS: return "dobfs";
+        case Method::PBFS: return "pbfs";
+    }
+    return "?";
 }
 
-void BFSD_list(const int vertex, const Graph &graph, std::vector<int> &dist) {
-    std::queue<int> q;
-    q.push(vertex);
-    dist[vertex] = 0;
+std::string search_label(const Representation representation, const Method method) {
+    // Direction-optimizing BFS has a single implementation over CSR (plus the matrix when present)
+    if (method == Method::DOBFS) return method_name(method);
+    return std::string(representation_name(representation)) + " " + method_name(method);
+}
 
-    std::cout << "Vertex traversal order: " << std::endl;
-    while (!q.empty()) {
-        const int current_vertex = q.front();
-        q.pop();
-        std::cout << current_vertex << " ";
-        for (const int neigh : graph.adj_list[current_vertex]) {
-            if (dist[neigh] == -1) {
-                q.push(neigh);
-                dist[neigh] = dist[current_vertex] + 1;
-            }
+SearchKernel search_kernel(const Representation representation, const Method method) {
+    if (method == Method::DOBFS) return BFSD_do_no_print;
+    if (method == Method::PBFS) {
+        switch (representation) {
+            case Representation::Matrix: return BFSD_par_matrix_no_print;
+            case Representation::List: return BFSD_par_list_no_print;
+            case Representation::CSR: return BFSD_par_csr_no_print;
         }
     }
-
-    std::cout << std::endl;
+    switch (representation) {
+        case Representation::Matrix: return method == Method::BFS ? BFSD_no_print : DFSD_no_print;
+        case Representation::List: return method == Method::BFS ? BFSD_list_no_print : DFSD_list_no_print;
+        case Representation::CSR: return method == Method::BFS ? BFSD_csr_no_print : DFSD_csr_no_print;
+    }
+    return nullptr;
 }
 
-void DFSD(const int vertex, const Graph &graph, std::vector<int> &dist) {
-    std::stack<int> stack;
+long long time_search(const Graph& graph, const int vertex, const Representation representation, const Method method) {
+    TraversalWorkspace workspace(graph.n);
+    const SearchKernel kernel = search_kernel(representation, method);
 
-    dist[vertex] = 0;
-    stack.push(vertex);
-
-    while (!stack.empty()) {
-        const int current = stack.top();
-        stack.pop();
+    PerfCounters counters;
+    const auto start = std::chrono::high_resolution_clock::now();
+    kernel(vertex, graph, workspace);
+    const auto end = std::chrono::high_resolution_clock::now();
+    counters.stop(workspace.stats);
+    stats_record(search_label(representation, method), workspace.stats);
 
-        std::cout << current << " ";
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
 
-        for (int i = graph.n - 1; i >= 0; i--) {
-            if (graph.adj_matrix[current][i] == 1 && dist[i] == -1) {
-                dist[i] = dist[current] + 1;
-                stack.push(i);
-            }
-        }
-    }
 
-    std::cout << std::endl;
+namespace {
+    constexpr std::string_view ORDER_HEADER = "Vertex traversal order: \n";
 }
 
-void DFSD_list(const int vertex, const Graph &graph, std::vector<int> &dist) {
-    std::stack<int> stack;
+void BFSD(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    run_search<QueueFrontier, MatrixRows>(vertex, graph, workspace, PrintVisitor(graph, std::cout, ORDER_HEADER));
+}
 
-    dist[vertex] = 0;
-    stack.push(vertex);
+void BFSD_list(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    run_search<QueueFrontier, ListRows>(vertex, graph, workspace, PrintVisitor(graph, std::cout, ORDER_HEADER));
+}
 
-    while (!stack.empty()) {
-        const int current = stack.top();
-        stack.pop();
-        std::cout << current << " ";
+void BFSD_csr(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    run_search<QueueFrontier, CSRRows>(vertex, graph, workspace, PrintVisitor(graph, std::cout, ORDER_HEADER));
+}
 
-        for (auto it = graph.adj_list[current].rbegin(); it != graph.adj_list[current].rend(); ++it) {
-            if (const int neigh = *it; dist[neigh] == -1) {
-                dist[neigh] = dist[current] + 1;
-                stack.push(neigh);
-            }
-        }
-    }
+void DFSD(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    run_search<StackFrontier, MatrixRows>(vertex, graph, workspace, PrintVisitor(graph, std::cout));
+}
 
-    std::cout << std::endl;
+void DFSD_list(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    run_search<StackFrontier, ListRows>(vertex, graph, workspace, PrintVisitor(graph, std::cout));
 }
 
+void DFSD_csr(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    run_search<StackFrontier, CSRRows>(vertex, graph, workspace, PrintVisitor(graph, std::cout));
+}
 
-void BFSD_no_print(const int vertex, const Graph &graph, std::vector<int> &dist) {
-    std::queue<int> q;
-    q.push(vertex);
-    dist[vertex] = 0;
+void BFSD_no_print(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    run_search<QueueFrontier, MatrixRows>(vertex, graph, workspace, NullVisitor());
+}
 
-    while (!q.empty()) {
-        const int current_vertex = q.front();
-        q.pop();
-        for (int i = 0; i < graph.n; i++) {
-            if (graph.adj_matrix[current_vertex][i] == 1 && dist[i] == -1) {
-                q.push(i);
-                dist[i] = dist[current_vertex] + 1;
-            }
-        }
-    }
+void DFSD_no_print(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    run_search<StackFrontier, MatrixRows>(vertex, graph, workspace, NullVisitor());
 }
 
-void DFSD_no_print(const int vertex, const Graph &graph, std::vector<int> &dist) {
-    std::stack<int> stack;
-    dist[vertex] = 0;
-    stack.push(vertex);
+void BFSD_list_no_print(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    run_search<QueueFrontier, ListRows>(vertex, graph, workspace, NullVisitor());
+}
 
-    while (!stack.empty()) {
-        const int current = stack.top();
-        stack.pop();
-        for (int i = graph.n - 1; i >= 0; i--) {
-            if (graph.adj_matrix[current][i] == 1 && dist[i] == -1) {
-                dist[i] = dist[current] + 1;
-                stack.push(i);
-            }
-        }
-    }
+void DFSD_list_no_print(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    run_search<StackFrontier, ListRows>(vertex, graph, workspace, NullVisitor());
 }
 
-void BFSD_list_no_print(const int vertex, const Graph &graph, std::vector<int> &dist) {
-    std::queue<int> q;
-    q.push(vertex);
-    dist[vertex] = 0;
+void BFSD_csr_no_print(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    run_search<QueueFrontier, CSRRows>(vertex, graph, workspace, NullVisitor());
+}
 
-    while (!q.empty()) {
-        const int current_vertex = q.front();
-        q.pop();
-        for (const int neigh : graph.adj_list[current_vertex]) {
-            if (dist[neigh] == -1) {
-                q.push(neigh);
-                dist[neigh] = dist[current_vertex] + 1;
-            }
-        }
-    }
+void DFSD_csr_no_print(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    run_search<StackFrontier, CSRRows>(vertex, graph, workspace, NullVisitor());
 }
 
-void DFSD_list_no_print(const int vertex, const Graph &graph, std::vector<int> &dist) {
-    std::stack<int> stack;
-    dist[vertex] = 0;
-    stack.push(vertex);
 
-    while (!stack.empty()) {
-        const int current = stack.top();
-        stack.pop();
-        for (auto it = graph.adj_list[current].rbegin(); it != graph.adj_list[current].rend(); ++it) {
-            if (const int neigh = *it; dist[neigh] == -1) {
-                dist[neigh] = dist[current] + 1;
-                stack.push(neigh);
-            }
+void compare(const Graph &graph, const int threads, std::ostream &output, JobControl *job, DistanceMatrix *all_pairs) {
+    const int n = graph.n;
+    const int workers = threads > 0 ? threads : hardware_threads();
+    DistanceMatrix dist_matrix;
+    std::vector<int> row_distances(n);
+
+    output << "Matrix row scan: " << row_scan_isa() << std::endl;
+
+    // Weighted engines are skipped when their distances could overflow the int buffers
+    std::string weighted_skip;
+    try {
+        check_weighted_range(graph);
+    } catch (const std::overflow_error& e) {
+        weighted_skip = e.what();
+    }
+
+    if (job != nullptr) {
+        // BFS and DFS per loaded representation, direction-optimizing BFS, the two weighted engines and MS-BFS,
+        // each run single-threaded and again on the pool
+        int engines = 2;
+        for (const Representation representation : {Representation::Matrix, Representation::List, Representation::CSR}) {
+            if (has_representation(graph, representation)) engines += 2;
         }
+        if (weighted_skip.empty() && has_representation(graph, Representation::CSR)) engines += 2;
+        job->expect(static_cast<long long>(engines) * (workers > 1 ? 2 : 1) * n);
     }
-}
 
-void compare(const Graph &graph) {
-    const int n = graph.n;
+    stats_begin("compare (all sources)");
 
-    auto run_method = [&](const std::string& name, auto search_func) {
-        std::vector<std::vector<int>> dist_matrix(n, std::vector<int>(n, -1));
+    // engine(pool_size) fills dist_matrix with the distances from every source and returns its counters
+    auto timed_run = [&](const auto& engine, const int pool_size, TraversalStats& stats) {
+        dist_matrix.reset(n);
+        PerfCounters counters;
         const auto start = std::chrono::high_resolution_clock::now();
-
-        for (int i = 0; i < n; i++) {
-            std::vector<int> dist(n, -1);
-            search_func(i, graph, dist);
-            dist_matrix[i] = dist;
-        }
-
+        stats = engine(pool_size);
         const auto end = std::chrono::high_resolution_clock::now();
-        const auto time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-        const double timeInSeconds = static_cast<double>(time) / 1000000.0;
+        // Hardware counters only follow the calling thread, so they are kept for the single-threaded run
+        if (pool_size == 1) counters.stop(stats);
+        job_checkpoint(job);
+        return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    };
 
-        std::cout << name << ": " << time << " us = " << timeInSeconds << " s"  << std::endl;
-        std::cout << "    ";
-        for (int j = 0; j < n; j++) {
-            std::cout << std::setw(3) << j << " ";
+    auto run_engine = [&](const std::string& name, const auto& engine) {
+        TraversalStats stats;
+        TraversalStats parallel_stats;
+        const auto time = timed_run(engine, 1, stats);
+        if (stats.searches > 0) stats_record(name, stats);
+        const double timeInSeconds = static_cast<double>(time) / 1000000.0;
+        TextBuffer out(output);
+        out << name << ": " << time << " us = " << timeInSeconds << " s\n";
+
+        if (workers > 1) {
+            const auto parallel_time = timed_run(engine, workers, parallel_stats);
+            const double speedup = parallel_time > 0 ? static_cast<double>(time) / static_cast<double>(parallel_time) : 0.0;
+            out << name << " (" << workers << " threads): " << parallel_time << " us = "
+                << static_cast<double>(parallel_time) / 1000000.0 << " s, speedup x" << speedup << '\n';
         }
-        std::cout << std::endl;
 
+        // Column widths come from the widest distance and vertex index, so nothing is measured per cell
+        const int max_distance = dist_matrix.max_distance();
+        const int label_width = std::max(2, TextBuffer::width_of(n - 1));
+        const int cell_width = std::max({3, TextBuffer::width_of(n - 1), TextBuffer::width_of(max_distance)});
 
-        std::cout << "   +";
+        out.repeat(' ', label_width + 2);
         for (int j = 0; j < n; j++) {
-            std::cout << "----";
+            out.right(j, cell_width) << ' ';
         }
-        std::cout << std::endl;
+        out << '\n';
 
+        out.repeat(' ', label_width + 1) << '+';
+        out.repeat('-', static_cast<std::size_t>(n) * (cell_width + 1)) << '\n';
 
+        // Rows and columns follow the original vertex ids
         for (int i = 0; i < n; i++) {
-            std::cout << std::setw(2) << i << " |";
+            out.right(i, label_width) << " |";
+            dist_matrix.copy_row(current_id(graph, i), row_distances);
             for (int j = 0; j < n; j++) {
-                std::cout << std::setw(3) <<dist_matrix[i][j] << " ";
+                out.right(row_distances[current_id(graph, j)], cell_width) << ' ';
             }
-            std::cout << std::endl;
+            out << '\n';
         }
-        std::cout << "*" <<std::setfill('-') << std::setw(n * 4 + 6) << "*" << std::setfill(' ') << std::endl;
+        out << '*';
+        out.repeat('-', static_cast<std::size_t>(n) * (cell_width + 1) + label_width + 3) << "*\n";
     };
 
-    run_method("DFSD", DFSD_no_print);
-    run_method("DFSD_list", DFSD_list_no_print);
-    run_method("BFSD", BFSD_no_print);
-    run_method("BFSD_list", BFSD_list_no_print);
+    auto run_method = [&](const std::string& name, const Representation representation, const SearchKernel kernel) {
+        if (!has_representation(graph, representation)) {
+            output << name << ": skipped, representation not loaded" << std::endl;
+            return;
+        }
+        run_engine(name, [&](const int pool_size) { return all_pairs_distances(graph, kernel, pool_size, dist_matrix, job); });
+    };
+
+    run_method("DFSD", Representation::Matrix, DFSD_no_print);
+    run_method("DFSD_list", Representation::List, DFSD_list_no_print);
+    run_method("DFSD_csr", Representation::CSR, DFSD_csr_no_print);
+    run_method("BFSD", Representation::Matrix, BFSD_no_print);
+    run_method("BFSD_list", Representation::List, BFSD_list_no_print);
+    run_method("BFSD_csr", Representation::CSR, BFSD_csr_no_print);
+    run_method("BFSD_do", Representation::CSR, BFSD_do_no_print);
+    // Weighted distances (hop counts on unweighted graphs); the pool splits the sources, so each search is sequential
+    if (weighted_skip.empty()) {
+        run_method("Dijkstra", Representation::CSR, dijkstra);
+        run_method("Delta-stepping", Representation::CSR, delta_stepping_single);
+    } else {
+        output << "Dijkstra, Delta-stepping: skipped, " << weighted_skip << std::endl;
+    }
+    // MS-BFS shares one traversal between many sources and has no per-search counters
+    run_engine("MS-BFS", [&](const int pool_size) {
+        all_pairs_msbfs(graph, pool_size, dist_matrix, job);
+        return TraversalStats();
+    });
+
+    output << "Distance matrix: " << dist_matrix.cell_bytes() << "-byte cells, " << dist_matrix.bytes() << " bytes" << std::endl;
+
+    // The last engine is a BFS, so the matrix holds true distances
+    if (all_pairs != nullptr) *all_pairs = std::move(dist_matrix);
 }
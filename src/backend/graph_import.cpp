@@ -0,0 +1,301 @@
+#include "../../include/backend/graph_import.h"
+#include "../../include/backend/generators.h"
+#include "../../include/backend/jobs.h"
+#include "../../include/backend/mapped_file.h"
+#include "../../include/backend/parallel.h"
+#include "../../include/backend/shortest_paths.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+    // Bytes parsed per work item; every chunk is extended to the end of its last line
+    constexpr std::size_t CHUNK_BYTES = std::size_t{8} << 20;
+
+    // Dense renumbering is used while the largest id is at most this many times the endpoint count
+    constexpr long long DENSE_ID_FACTOR = 16;
+
+    struct RawEdge {
+        std::int64_t u;
+        std::int64_t v;
+        std::uint32_t weight;
+    };
+
+    bool is_blank(const char c) { return c == ' ' || c == '\t' || c == '\r'; }
+    bool is_separator(const char c) { return c == ' ' || c == '\t' || c == ','; }
+
+    const char* line_end(const char* first, const char* last) {
+        const void* found = std::memchr(first, '\n', static_cast<std::size_t>(last - first));
+        return found != nullptr ? static_cast<const char*>(found) : last;
+    }
+
+    std::runtime_error malformed(const char* first, const char* last) {
+        const std::string_view line(first, static_cast<std::size_t>(std::min<std::ptrdiff_t>(last - first, 60)));
+        return std::runtime_error("malformed edge line \"" + std::string(line) + "\"");
+    }
+
+    // Parse the "u v" lines ("u v w" when weighted) of [first, last), which starts at a line start and ends at a line end
+    void parse_lines(const char* first, const char* last, const bool weighted, std::vector<RawEdge>& edges, std::int64_t& max_id) {
+        while (first < last) {
+            const char* end = line_end(first, last);
+            const char* p = first;
+            while (p != end && is_blank(*p)) p++;
+
+            if (p != end && *p != '#' && *p != '%') {
+                RawEdge edge{0, 0, 1};
+                auto [middle, error] = std::from_chars(p, end, edge.u);
+                while (error == std::errc() && middle != end && is_separator(*middle)) middle++;
+                if (error == std::errc()) {
+                    const auto parsed = std::from_chars(middle, end, edge.v);
+                    middle = parsed.ptr;
+                    error = parsed.ec;
+                }
+                if (error != std::errc() || edge.u < 0 || edge.v < 0) throw malformed(first, end);
+                if (weighted) {
+                    // Positive integer weights only: "2.5" stops at the '.' and is rejected
+                    while (middle != end && is_separator(*middle)) middle++;
+                    long long weight = 0;
+                    const auto [rest, weight_error] = std::from_chars(middle, end, weight);
+                    if (weight_error != std::errc() || weight < 1 || weight > INT_MAX || (rest != end && !is_blank(*rest) && *rest != ',')) {
+                        throw malformed(first, end);
+                    }
+                    edge.weight = static_cast<std::uint32_t>(weight);
+                }
+                max_id = std::max({max_id, edge.u, edge.v});
+                edges.push_back(edge);
+            }
+            first = end + 1;
+        }
+    }
+
+    // Chunk bounds over [begin, size), each cut just after a line break
+    std::vector<std::size_t> chunk_bounds(const char* data, const std::size_t begin, const std::size_t size) {
+        std::vector<std::size_t> bounds = {begin};
+        while (bounds.back() < size) {
+            const std::size_t cut = std::min(bounds.back() + CHUNK_BYTES, size);
+            bounds.push_back(cut == size ? size : static_cast<std::size_t>(line_end(data + cut, data + size) - data) + 1);
+        }
+        bounds.back() = std::min(bounds.back(), size);
+        return bounds;
+    }
+
+    struct MatrixMarketHeader {
+        std::size_t entries_begin = 0;
+        int n = 0;
+        long long entries = 0;
+    };
+
+    // Check the banner and read the size line of a coordinate Matrix Market file
+    MatrixMarketHeader read_mtx_header(const char* data, const std::size_t size) {
+        const char* last = data + size;
+        const char* end = line_end(data, last);
+        std::string banner(data, end);
+        std::transform(banner.begin(), banner.end(), banner.begin(), [](const char c) {
+            return static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+        });
+        if (!banner.starts_with("%%matrixmarket")) throw std::runtime_error("missing %%MatrixMarket banner");
+        if (banner.find("coordinate") == std::string::npos) {
+            throw std::runtime_error("only coordinate Matrix Market files can be imported");
+        }
+
+        for (const char* line = end + 1; line < last; line = end + 1) {
+            end = line_end(line, last);
+            const char* p = line;
+            while (p != end && is_blank(*p)) p++;
+            if (p == end || *p == '%') continue;
+
+            long long dims[3] = {};
+            for (long long& dim : dims) {
+                while (p != end && is_blank(*p)) p++;
+                const auto [next, error] = std::from_chars(p, end, dim);
+                if (error != std::errc() || dim < 0) throw std::runtime_error("malformed Matrix Market size line");
+                p = next;
+            }
+            const long long vertices = std::max(dims[0], dims[1]);
+            if (vertices < 1 || vertices > INT_MAX) throw std::runtime_error("Matrix Market size out of range");
+            return {static_cast<std::size_t>(end - data) + (end == last ? 0 : 1), static_cast<int>(vertices), dims[2]};
+        }
+        throw std::runtime_error("missing Matrix Market size line");
+    }
+
+    EdgeListFormat detect_format(const std::string& path, const char* data, const std::size_t size) {
+        const std::string_view head(data, std::min<std::size_t>(size, 14));
+        if (head == "%%MatrixMarket" || path.ends_with(".mtx")) return EdgeListFormat::MatrixMarket;
+        if (size > 0 && data[0] == '#') return EdgeListFormat::SNAP;
+        return EdgeListFormat::EdgeList;
+    }
+}
+
+const char* format_name(const EdgeListFormat format) {
+    switch (format) {
+        case EdgeListFormat::Auto: return "auto";
+        case EdgeListFormat::SNAP: return "snap";
+        case EdgeListFormat::MatrixMarket: return "mtx";
+        case EdgeListFormat::EdgeList: return "edgelist";
+    }
+    return "?";
+}
+
+EdgeListFormat parse_edge_list_format(const std::string& name) {
+    if (name == "auto") return EdgeListFormat::Auto;
+    if (name == "snap") return EdgeListFormat::SNAP;
+    if (name == "mtx") return EdgeListFormat::MatrixMarket;
+    if (name == "edgelist") return EdgeListFormat::EdgeList;
+    throw std::invalid_argument("unknown format: " + name);
+}
+
+Graph import_edge_list(const std::string& path, EdgeListFormat format, const bool weighted, ImportSummary* summary,
+                       JobControl* job) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    const MappedFile file(path);
+    const char* data = file.bytes();
+    const auto size = static_cast<std::size_t>(file.size);
+    const int threads = hardware_threads();
+
+    if (format == EdgeListFormat::Auto) format = detect_format(path, data, size);
+    const bool matrix_market = format == EdgeListFormat::MatrixMarket;
+    MatrixMarketHeader header;
+    if (matrix_market) {
+        try {
+            header = read_mtx_header(data, size);
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error(path + ": " + e.what());
+        }
+    }
+
+    // Parse: one edge vector per chunk keeps the file order, errors are rethrown on this thread
+    const std::vector<std::size_t> bounds = chunk_bounds(data, header.entries_begin, size);
+    const int chunks = static_cast<int>(bounds.size()) - 1;
+    std::vector<std::vector<RawEdge>> parsed(chunks);
+    std::vector<std::int64_t> chunk_max(chunks, -1);
+    std::vector<std::string> errors(chunks);
+    if (job != nullptr) job->expect(chunks);
+
+    parallel_for(0, chunks, threads, [&](const int c, int) {
+        if (job != nullptr && job->cancel_requested()) return;
+        try {
+            parse_lines(data + bounds[c], data + bounds[c + 1], weighted, parsed[c], chunk_max[c]);
+        } catch (const std::exception& e) {
+            errors[c] = e.what();
+        }
+        if (job != nullptr) job->advance();
+    });
+    job_checkpoint(job);
+    for (const auto& error : errors) {
+        if (!error.empty()) throw std::runtime_error(path + ": " + error);
+    }
+
+    std::vector<std::size_t> offsets(static_cast<std::size_t>(chunks) + 1, 0);
+    std::int64_t max_id = -1;
+    for (int c = 0; c < chunks; c++) {
+        offsets[c + 1] = offsets[c] + parsed[c].size();
+        max_id = std::max(max_id, chunk_max[c]);
+    }
+    const auto total = static_cast<long long>(offsets[chunks]);
+
+    // Vertex id of every file id
+    int n = 0;
+    bool compacted = false;
+    std::vector<int> dense_ids;
+    std::vector<std::int64_t> sorted_ids;
+    if (matrix_market) {
+        if (total != header.entries) {
+            throw std::runtime_error(path + ": expected " + std::to_string(header.entries) + " entries, found " +
+                                     std::to_string(total));
+        }
+        if (total > 0 && max_id > header.n) throw std::runtime_error(path + ": entry outside the declared size");
+        n = header.n;
+    } else if (max_id < INT_MAX && max_id < DENSE_ID_FACTOR * 2 * total + 1024) {
+        dense_ids.assign(static_cast<std::size_t>(max_id + 1), -1);
+        // Threads mark the ids that occur; concurrent marks of one id store the same value
+        parallel_for(0, chunks, threads, [&](const int c, int) {
+            for (const auto& [u, v, weight] : parsed[c]) {
+                std::atomic_ref<int>(dense_ids[u]).store(0, std::memory_order_relaxed);
+                std::atomic_ref<int>(dense_ids[v]).store(0, std::memory_order_relaxed);
+            }
+        });
+        for (int& id : dense_ids) {
+            if (id == 0) id = n++;
+        }
+        compacted = n != max_id + 1;
+    } else {
+        // Ids too large or too sparse for a lookup table: sort the distinct ones
+        sorted_ids.reserve(static_cast<std::size_t>(2 * total));
+        for (const auto& chunk : parsed) {
+            for (const auto& [u, v, weight] : chunk) {
+                sorted_ids.push_back(u);
+                sorted_ids.push_back(v);
+            }
+        }
+        std::sort(sorted_ids.begin(), sorted_ids.end());
+        sorted_ids.erase(std::unique(sorted_ids.begin(), sorted_ids.end()), sorted_ids.end());
+        if (sorted_ids.size() > static_cast<std::size_t>(INT_MAX)) throw std::runtime_error(path + ": too many vertices");
+        n = static_cast<int>(sorted_ids.size());
+        compacted = true;
+    }
+    if (n == 0) throw std::runtime_error(path + ": no edges found");
+
+    if (matrix_market) {
+        for (const auto& chunk : parsed) {
+            for (const auto& [u, v, weight] : chunk) {
+                if (u < 1 || v < 1) throw std::runtime_error(path + ": Matrix Market ids start at 1");
+            }
+        }
+    }
+    auto vertex = [&](const std::int64_t id) {
+        if (matrix_market) return static_cast<int>(id - 1);
+        if (!dense_ids.empty()) return dense_ids[id];
+        return static_cast<int>(std::lower_bound(sorted_ids.begin(), sorted_ids.end(), id) - sorted_ids.begin());
+    };
+
+    // Renumber chunk by chunk in parallel, freeing the parsed ids as they are consumed
+    std::vector<std::pair<int, int>> edges(static_cast<std::size_t>(total));
+    std::vector<std::uint32_t> weights(weighted ? static_cast<std::size_t>(total) : 0);
+    parallel_for(0, chunks, threads, [&](const int c, int) {
+        std::size_t out = offsets[c];
+        for (const auto& [u, v, weight] : parsed[c]) {
+            if (weighted) weights[out] = weight;
+            edges[out++] = {vertex(u), vertex(v)};
+        }
+        std::vector<RawEdge>().swap(parsed[c]);
+    });
+    dense_ids = std::vector<int>();
+    sorted_ids = std::vector<std::int64_t>();
+
+    Graph graph = graph_from_edges(n, edges, true, job);
+    if (weighted) assign_edge_weights(graph, edges, weights);
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    if (summary != nullptr) {
+        summary->format = format;
+        summary->edges_read = total;
+        summary->compacted = compacted;
+        summary->weighted = weighted;
+        summary->elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    }
+    return graph;
+}
+
+void print_import_summary(const Graph& graph, const ImportSummary& summary, std::ostream& output) {
+    output << "Imported " << format_name(summary.format) << " graph with " << graph.n << " vertices and "
+           << edge_count(graph) << " edges from " << summary.edges_read << " edge lines in "
+           << summary.elapsed_us / 1000 << " ms" << std::endl;
+    if (summary.compacted) {
+        output << "  Vertex ids compacted to 0.." << graph.n - 1 << " in ascending order of the file ids" << std::endl;
+    }
+    if (summary.weighted) {
+        output << "  Edge weights: 1.." << max_edge_weight(graph) << " (repeated edges keep the smallest)" << std::endl;
+    }
+    if (graph.adj_matrix.empty()) {
+        output << "  Adjacency matrix skipped: it would take more than " << (GENERATED_MATRIX_LIMIT >> 20) << " MiB" << std::endl;
+    }
+}
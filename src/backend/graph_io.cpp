@@ -0,0 +1,194 @@
+#include "../../include/backend/graph_io.h"
+#include "../../include/backend/mapped_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+    constexpr char MAGIC[8] = {'L', 'A', 'B', '9', 'G', 'R', 'P', 'H'};
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+    constexpr std::uint64_t SECTION_ALIGNMENT = 64;
+
+    std::uint64_t align_up(const std::uint64_t pos) {
+        return (pos + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+    }
+
+    void write_bytes(std::ofstream& out, const void* data, const std::uint64_t size) {
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+
+    void pad_to(std::ofstream& out, const std::uint64_t pos) {
+        static constexpr char zeros[SECTION_ALIGNMENT] = {};
+        const auto current = static_cast<std::uint64_t>(out.tellp());
+        write_bytes(out, zeros, pos - current);
+    }
+
+    /*
+     * Everything the searches trust about the mapped sections: offsets non-decreasing, rows strictly ascending
+     * with ids in [0, n) (has_edge and add_edge binary-search them), and the matrix, if stored, holding exactly
+     * the row entries with its padding bits clear (the row scans would report columns past n otherwise)
+     */
+    void verify_sections(const std::string& path, const Graph& graph) {
+        const int n = graph.n;
+        const auto offsets = graph.adj_csr.offsets();
+        const auto neighbours = graph.adj_csr.neighbours();
+        for (int v = 0; v < n; v++) {
+            if (offsets[v] > offsets[v + 1]) throw std::runtime_error(path + " has inconsistent offsets/neighbours");
+        }
+        for (int v = 0; v < n; v++) {
+            int previous = -1;
+            for (const int u : graph.adj_csr.row(v)) {
+                if (u <= previous || u >= n) throw std::runtime_error(path + " has inconsistent offsets/neighbours");
+                previous = u;
+            }
+        }
+
+        const BitMatrix& matrix = graph.adj_matrix;
+        if (matrix.empty()) return;
+        const std::size_t used_words = (static_cast<std::size_t>(n) + BitMatrix::word_bits - 1) / BitMatrix::word_bits;
+        const int tail_bits = n % BitMatrix::word_bits;
+        const BitMatrix::word_type tail_mask = tail_bits == 0 ? 0 : ~BitMatrix::word_type{0} << tail_bits;
+        for (int v = 0; v < n; v++) {
+            const BitMatrix::word_type* row = matrix.row(v);
+            bool padding_clear = (row[used_words - 1] & tail_mask) == 0;
+            for (std::size_t w = used_words; w < matrix.words_per_row(); w++) {
+                padding_clear = padding_clear && row[w] == 0;
+            }
+            if (!padding_clear) throw std::runtime_error(path + " has matrix bits set past column n");
+            const auto entries = graph.adj_csr.row(v);
+            const bool same_row = matrix.row_count(v) == entries.size()
+                && std::all_of(entries.begin(), entries.end(), [&](const int u) { return matrix.test(v, u); });
+            if (!same_row) throw std::runtime_error(path + " has a matrix that does not match its CSR rows");
+        }
+    }
+}
+
+void save_graph(const Graph &graph, const std::string &path, const bool with_matrix) {
+    const CSRAdjacency& csr = graph.adj_csr;
+    if (csr.empty()) throw std::runtime_error("graph has no CSR arrays to save");
+
+    const bool store_matrix = with_matrix && !graph.adj_matrix.empty();
+
+    GraphFileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = GRAPH_FILE_VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    const bool reordered = !graph.original_ids.empty();
+    header.flags = (store_matrix ? GRAPH_FILE_HAS_MATRIX : 0) | (is_weighted(graph) ? GRAPH_FILE_HAS_WEIGHTS : 0)
+                 | (reordered ? GRAPH_FILE_HAS_PERMUTATION : 0);
+    header.n = graph.n;
+    header.entries = static_cast<std::int64_t>(csr.neighbours().size());
+    header.offsets_pos = align_up(sizeof(GraphFileHeader));
+    header.neighbours_pos = align_up(header.offsets_pos + csr.offsets().size_bytes());
+    std::uint64_t end = header.neighbours_pos + csr.neighbours().size_bytes();
+    if (is_weighted(graph)) {
+        header.weights_pos = align_up(end);
+        end = header.weights_pos + graph.weights.size() * sizeof(std::uint32_t);
+    }
+    if (reordered) {
+        header.permutation_pos = align_up(end);
+        end = header.permutation_pos + graph.original_ids.size() * sizeof(int);
+    }
+    if (store_matrix) {
+        header.matrix_pos = align_up(end);
+        header.matrix_stride = graph.adj_matrix.words_per_row();
+        end = header.matrix_pos + graph.adj_matrix.bytes();
+    }
+    header.file_size = end;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("cannot create " + path);
+
+    write_bytes(out, &header, sizeof(header));
+    pad_to(out, header.offsets_pos);
+    write_bytes(out, csr.offsets().data(), csr.offsets().size_bytes());
+    pad_to(out, header.neighbours_pos);
+    write_bytes(out, csr.neighbours().data(), csr.neighbours().size_bytes());
+    if (is_weighted(graph)) {
+        pad_to(out, header.weights_pos);
+        write_bytes(out, graph.weights.data(), graph.weights.size() * sizeof(std::uint32_t));
+    }
+    if (reordered) {
+        pad_to(out, header.permutation_pos);
+        write_bytes(out, graph.original_ids.data(), graph.original_ids.size() * sizeof(int));
+    }
+    if (store_matrix) {
+        pad_to(out, header.matrix_pos);
+        write_bytes(out, graph.adj_matrix.row(0), graph.adj_matrix.bytes());
+    }
+
+    if (!out.flush()) throw std::runtime_error("cannot write " + path);
+}
+
+Graph load_graph(const std::string &path, const bool verify) {
+    auto file = std::make_shared<MappedFile>(path);
+    if (file->size < sizeof(GraphFileHeader)) throw std::runtime_error(path + " is not a graph file");
+
+    GraphFileHeader header{};
+    std::memcpy(&header, file->bytes(), sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) throw std::runtime_error(path + " is not a graph file");
+    if (header.byte_order != BYTE_ORDER_MARK) throw std::runtime_error(path + " was written with another byte order");
+    if (header.version < 1 || header.version > GRAPH_FILE_VERSION) {
+        throw std::runtime_error(path + " has unsupported version " + std::to_string(header.version));
+    }
+
+    const auto offsets_bytes = static_cast<std::uint64_t>(header.n + 1) * sizeof(std::int64_t);
+    const auto neighbours_bytes = static_cast<std::uint64_t>(header.entries) * sizeof(int);
+    const bool has_matrix = (header.flags & GRAPH_FILE_HAS_MATRIX) != 0;
+    const bool has_weights = header.version >= 2 && (header.flags & GRAPH_FILE_HAS_WEIGHTS) != 0;
+    const auto weights_bytes = static_cast<std::uint64_t>(header.entries) * sizeof(std::uint32_t);
+    const bool has_permutation = header.version >= 3 && (header.flags & GRAPH_FILE_HAS_PERMUTATION) != 0;
+    const auto permutation_bytes = static_cast<std::uint64_t>(header.n) * sizeof(int);
+    const bool sections_valid = header.n > 0 && header.n <= INT32_MAX && header.entries >= 0
+        && header.file_size == file->size
+        && header.offsets_pos % SECTION_ALIGNMENT == 0 && header.neighbours_pos % SECTION_ALIGNMENT == 0
+        && header.offsets_pos + offsets_bytes <= file->size
+        && header.neighbours_pos + neighbours_bytes <= file->size
+        && (!has_weights || (header.weights_pos % SECTION_ALIGNMENT == 0 && header.weights_pos + weights_bytes <= file->size))
+        && (!has_permutation || (header.permutation_pos % SECTION_ALIGNMENT == 0
+                                 && header.permutation_pos + permutation_bytes <= file->size))
+        && (!has_matrix || (header.matrix_pos % SECTION_ALIGNMENT == 0
+                            && header.matrix_stride == BitMatrix::stride_for(static_cast<int>(header.n))
+                            && header.matrix_pos + static_cast<std::uint64_t>(header.n) * header.matrix_stride * 8 <= file->size));
+    if (!sections_valid) throw std::runtime_error(path + " is truncated or corrupted");
+
+    const auto* offsets = reinterpret_cast<const std::int64_t*>(file->bytes() + header.offsets_pos);
+    const auto* neighbours = reinterpret_cast<const int*>(file->bytes() + header.neighbours_pos);
+    if (offsets[0] != 0 || offsets[header.n] != header.entries) throw std::runtime_error(path + " has inconsistent offsets");
+
+    Graph graph;
+    graph.n = static_cast<int>(header.n);
+    graph.adj_csr = CSRAdjacency::view({offsets, static_cast<std::size_t>(header.n + 1)},
+                                       {neighbours, static_cast<std::size_t>(header.entries)}, file);
+    if (has_matrix) {
+        auto* words = reinterpret_cast<BitMatrix::word_type*>(file->bytes() + header.matrix_pos);
+        graph.adj_matrix = BitMatrix::view(words, graph.n, header.matrix_stride, file);
+    }
+    if (verify) verify_sections(path, graph);
+    if (has_weights) {
+        graph.weights.resize(static_cast<std::size_t>(header.entries));
+        std::memcpy(graph.weights.data(), file->bytes() + header.weights_pos, weights_bytes);
+        // The shortest path engines assume positive weights
+        if (std::find(graph.weights.begin(), graph.weights.end(), 0u) != graph.weights.end()) {
+            throw std::runtime_error(path + " has non-positive edge weights");
+        }
+    }
+    if (has_permutation) {
+        graph.original_ids.resize(static_cast<std::size_t>(graph.n));
+        std::memcpy(graph.original_ids.data(), file->bytes() + header.permutation_pos, permutation_bytes);
+        graph.current_ids.assign(static_cast<std::size_t>(graph.n), -1);
+        for (int v = 0; v < graph.n; v++) {
+            const int original = graph.original_ids[v];
+            if (original < 0 || original >= graph.n || graph.current_ids[original] != -1) {
+                throw std::runtime_error(path + " has an invalid vertex permutation");
+            }
+            graph.current_ids[original] = v;
+        }
+    }
+
+    return graph;
+}
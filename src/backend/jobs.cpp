@@ -0,0 +1,145 @@
+#include "../../include/backend/jobs.h"
+#include "../../include/backend/traversal_stats.h"
+
+#include <iomanip>
+#include <ranges>
+
+JobManager::~JobManager() {
+    cancel_all();
+}
+
+int JobManager::submit(std::string description, std::string unit, Task task, std::function<void()> on_wait) {
+    std::lock_guard lock(mutex);
+    auto job = std::make_unique<Job>();
+    Job& ref = *job;
+    ref.id = next_id++;
+    ref.description = std::move(description);
+    ref.unit = std::move(unit);
+    ref.on_wait = std::move(on_wait);
+    ref.started = Clock::now();
+
+    ref.thread = std::thread([this, &ref, body = std::move(task)] {
+        JobState state = JobState::Done;
+        std::string error;
+        try {
+            // The job's counters go with its own output, not into the report 'stats' shows
+            const StatsScope stats;
+            body(ref.control, ref.output);
+            stats.print(ref.output);
+        } catch (const JobCancelled&) {
+            state = JobState::Cancelled;
+        } catch (const std::exception& e) {
+            state = JobState::Failed;
+            error = e.what();
+        }
+
+        std::lock_guard finish_lock(mutex);
+        ref.error = std::move(error);
+        ref.finished = Clock::now();
+        ref.state.store(state);
+        job_finished.notify_all();
+    });
+
+    jobs.emplace(ref.id, std::move(job));
+    return ref.id;
+}
+
+void JobManager::list(std::ostream& out) const {
+    std::lock_guard lock(mutex);
+    if (jobs.empty()) {
+        out << "No background jobs" << std::endl;
+        return;
+    }
+    for (const auto& job : jobs | std::views::values) {
+        print_progress(*job, out);
+    }
+}
+
+std::vector<int> JobManager::ids() const {
+    std::lock_guard lock(mutex);
+    std::vector<int> result;
+    for (const int id : jobs | std::views::keys) {
+        result.push_back(id);
+    }
+    return result;
+}
+
+bool JobManager::cancel(const int id) {
+    std::lock_guard lock(mutex);
+    const auto it = jobs.find(id);
+    if (it == jobs.end()) return false;
+    it->second->control.cancel();
+    return true;
+}
+
+void JobManager::cancel_all() {
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard lock(mutex);
+        for (const auto& job : jobs | std::views::values) {
+            job->control.cancel();
+            if (job->thread.joinable()) threads.push_back(std::move(job->thread));
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::lock_guard lock(mutex);
+    jobs.clear();
+}
+
+std::optional<JobState> JobManager::wait(const int id, std::ostream& out) {
+    std::unique_lock lock(mutex);
+    const auto it = jobs.find(id);
+    if (it == jobs.end()) return std::nullopt;
+    Job& job = *it->second;
+
+    while (!job_finished.wait_for(lock, std::chrono::seconds(1), [&] { return job.state.load() != JobState::Running; })) {
+        print_progress(job, out);
+    }
+
+    // The job is finished and no other waiter can reach it once it leaves the map
+    std::unique_ptr<Job> owned = std::move(it->second);
+    jobs.erase(it);
+    lock.unlock();
+    owned->thread.join();
+
+    out << owned->output.str();
+    const JobState state = owned->state.load();
+    switch (state) {
+        case JobState::Done:
+            if (owned->on_wait) owned->on_wait();
+            break;
+        case JobState::Cancelled:
+            out << "Job [" << id << "] was cancelled" << std::endl;
+            break;
+        case JobState::Failed:
+            out << "Job [" << id << "] failed: " << owned->error << std::endl;
+            break;
+        case JobState::Running:
+            break;
+    }
+    return state;
+}
+
+void JobManager::print_progress(const Job& job, std::ostream& out) {
+    const JobState state = job.state.load();
+    const auto end = state == JobState::Running ? Clock::now() : job.finished;
+    const double seconds = std::chrono::duration<double>(end - job.started).count();
+    const long long done = job.control.completed();
+    const long long total = job.control.expected();
+
+    const char* name = state == JobState::Running ? (job.control.cancel_requested() ? "cancelling" : "running")
+                     : state == JobState::Done ? "done"
+                     : state == JobState::Cancelled ? "cancelled"
+                     : "failed";
+
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(1);
+    line << "[" << job.id << "] " << std::left << std::setw(10) << name << " " << job.description << ": "
+         << done << "/" << total << " " << job.unit << ", "
+         << (seconds > 0 ? static_cast<double>(done) / seconds : 0.0) << " " << job.unit << "/s, "
+         << seconds << " s";
+    out << line.str() << std::endl;
+}
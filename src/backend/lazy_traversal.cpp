@@ -0,0 +1,136 @@
+#include "../../include/backend/lazy_traversal.h"
+#include "../../include/backend/text_buffer.h"
+#include "../../include/backend/traversal_engine.h"
+#include "../../include/backend/traversal_stats.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    // A vertex is yielded right after it is visited; a row is expanded only once all earlier discoveries were pulled
+    template <class Rows>
+    Generator<Discovery> breadth_first(const Graph& graph, const int source, TraversalWorkspace& workspace, const int max_depth) {
+        workspace.begin();
+        Rows rows(graph, workspace);
+        workspace.visit(source, 0);
+        rows.mark(source);
+        workspace.enqueue(source);
+        co_yield Discovery{source, 0};
+
+        // The workspace records visits in discovery order, which is the order they are yielded in
+        std::size_t yielded = 1;
+        while (!workspace.queue_empty()) {
+            const int current = workspace.dequeue();
+            // Every vertex still queued is at least as far away
+            if (workspace.depth(current) >= max_depth) break;
+            const int next_depth = workspace.depth(current) + 1;
+
+            workspace.count_edges(rows.degree(current));
+            rows.for_each_new(current, [&](const int v) {
+                workspace.visit(v, next_depth);
+                workspace.enqueue(v);
+            });
+            for (; yielded < workspace.touched_vertices().size(); yielded++) {
+                co_yield Discovery{workspace.touched_vertices()[yielded], next_depth};
+            }
+        }
+    }
+
+    // A vertex is yielded when it is taken from the stack, before its row is expanded
+    template <class Rows>
+    Generator<Discovery> depth_first(const Graph& graph, const int source, TraversalWorkspace& workspace, const int max_depth) {
+        workspace.begin();
+        Rows rows(graph, workspace);
+        workspace.visit(source, 0);
+        rows.mark(source);
+        workspace.push(source);
+
+        while (!workspace.stack_empty()) {
+            const int current = workspace.pop();
+            const int depth = workspace.depth(current);
+            co_yield Discovery{current, depth};
+            if (depth >= max_depth) continue;
+
+            workspace.count_edges(rows.degree(current));
+            rows.for_each_new_reverse(current, [&](const int v) {
+                workspace.visit(v, depth + 1);
+                workspace.push(v);
+            });
+        }
+    }
+
+    template <class Rows>
+    Generator<Discovery> search(const Graph& graph, const int source, const Method method, TraversalWorkspace& workspace,
+                                const int max_depth) {
+        if (method == Method::BFS) return breadth_first<Rows>(graph, source, workspace, max_depth);
+        return depth_first<Rows>(graph, source, workspace, max_depth);
+    }
+}
+
+Generator<Discovery> traverse(const Graph& graph, const int source, const Representation representation, const Method method,
+                              TraversalWorkspace& workspace, const int max_depth) {
+    // Checked here, as the coroutine bodies only start on the first pull
+    if (method != Method::BFS && method != Method::DFS) {
+        throw std::invalid_argument(std::string("lazy traversal supports bfs and dfs, not ") + method_name(method));
+    }
+    switch (representation) {
+        case Representation::Matrix: return search<MatrixRows>(graph, source, method, workspace, max_depth);
+        case Representation::List: return search<ListRows>(graph, source, method, workspace, max_depth);
+        case Representation::CSR: break;
+    }
+    return search<CSRRows>(graph, source, method, workspace, max_depth);
+}
+
+long long prep_limited(const Graph& graph, const int source, const Representation representation, const Method method,
+                       const TraversalLimits& limits, std::ostream& output) {
+    TraversalWorkspace workspace(graph.n);
+    PerfCounters counters;
+    std::vector<Discovery> reached;
+    bool found = false;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (const Discovery& discovery : traverse(graph, source, representation, method, workspace, limits.max_depth)) {
+        reached.push_back(discovery);
+        if (discovery.vertex == limits.until) {
+            found = true;
+            break;
+        }
+        if (static_cast<long long>(reached.size()) >= limits.limit) break;
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    counters.stop(workspace.stats);
+
+    stats_begin("limited traversal from vertex " + std::to_string(original_id(graph, source)));
+    stats_record(search_label(representation, method), workspace.stats);
+
+    TextBuffer out(output);
+    out << "Vertex traversal order: \n";
+    for (const auto& [vertex, distance] : reached) {
+        out << original_id(graph, vertex) << ' ';
+    }
+    out << "\nDistances (vertex:distance):\n";
+    for (const auto& [vertex, distance] : reached) {
+        out << original_id(graph, vertex) << ':' << distance << ' ';
+    }
+    out << '\n';
+
+    const char* distance_kind = method == Method::BFS ? "distance" : "depth";
+    if (found) {
+        out << "Stopped at vertex " << original_id(graph, limits.until) << ", reached at " << distance_kind << ' '
+            << reached.back().distance << '\n';
+    } else if (static_cast<long long>(reached.size()) >= limits.limit) {
+        out << "Stopped after " << limits.limit << (limits.limit == 1 ? " vertex" : " vertices") << '\n';
+    } else {
+        if (limits.until != -1) {
+            out << "Vertex " << original_id(graph, limits.until) << " was not reached\n";
+        }
+        out << "Traversal complete";
+        if (limits.max_depth != INT_MAX) out << " up to " << distance_kind << ' ' << limits.max_depth;
+        out << '\n';
+    }
+    out << "Reached " << reached.size() << " of " << graph.n << " vertices\n";
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
@@ -0,0 +1,181 @@
+#include "../../include/backend/pbfs.h"
+#include "../../include/backend/parallel.h"
+#include "../../include/backend/text_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <thread>
+
+namespace {
+    using Word = BitMatrix::word_type;
+    constexpr int WORD_BITS = BitMatrix::word_bits;
+
+    // Frontier vertices taken per counter increment
+    constexpr std::size_t CHUNK = 64;
+
+    // Set the bits of mask in visited word w; returns the bits this call set first
+    Word claim(std::vector<Word>& visited, const std::size_t w, const Word mask) {
+        std::atomic_ref<Word> word(visited[w]);
+        const Word fresh = mask & ~word.load(std::memory_order_relaxed);
+        if (fresh == 0) return 0;
+        return fresh & ~word.fetch_or(fresh, std::memory_order_relaxed);
+    }
+
+    bool claim(std::vector<Word>& visited, const int v) {
+        return claim(visited, static_cast<std::size_t>(v) / WORD_BITS, Word{1} << (v % WORD_BITS)) != 0;
+    }
+
+    // Per-thread next-frontier buffer, on its own cache line
+    struct alignas(64) Local {
+        std::vector<int> next;
+        std::size_t edges = 0;
+    };
+
+    /**
+     * expand(u, next) appends the unvisited neighbours of u it claims in the visited bitmap
+     * and returns the number of adjacency entries it examined
+     */
+    template <class Expand>
+    void level_synchronous_bfs(const int vertex, const Graph& graph, TraversalWorkspace& workspace, const int threads,
+                               std::vector<Word>& visited, Expand&& expand) {
+        const int pool_size = std::clamp(threads > 0 ? threads : hardware_threads(), 1, std::max(graph.n, 1));
+
+        workspace.begin();
+        // All levels back to back: level l occupies [bounds[l], bounds[l + 1])
+        std::vector<int>& levels = workspace.frontier;
+        levels.resize(graph.n);
+        levels[0] = vertex;
+        claim(visited, vertex);
+        std::vector<std::size_t> bounds = {0, 1};
+
+        std::vector<Local> local(pool_size);
+        std::vector<std::size_t> offsets(pool_size + 1, 0);
+        std::atomic<std::size_t> cursor{0};
+
+        // Once the level is expanded: every buffer gets its place in the next level
+        auto on_expanded = [&]() noexcept {
+            for (int t = 0; t < pool_size; t++) {
+                offsets[t + 1] = offsets[t] + local[t].next.size();
+            }
+            cursor.store(0, std::memory_order_relaxed);
+        };
+        // Once the buffers are copied: the next level becomes the frontier
+        auto on_merged = [&]() noexcept { bounds.push_back(bounds.back() + offsets[pool_size]); };
+
+        std::barrier expanded(pool_size, on_expanded);
+        std::barrier merged(pool_size, on_merged);
+
+        auto worker = [&](const int thread_id) {
+            Local& mine = local[thread_id];
+            for (;;) {
+                const std::size_t level_begin = bounds[bounds.size() - 2];
+                const std::size_t level_end = bounds.back();
+                if (level_begin == level_end) return;
+
+                for (std::size_t first = level_begin + cursor.fetch_add(CHUNK, std::memory_order_relaxed); first < level_end;
+                     first = level_begin + cursor.fetch_add(CHUNK, std::memory_order_relaxed)) {
+                    const std::size_t last = std::min(first + CHUNK, level_end);
+                    for (std::size_t i = first; i < last; i++) {
+                        mine.edges += expand(levels[i], mine.next);
+                    }
+                }
+                expanded.arrive_and_wait();
+
+                std::copy(mine.next.begin(), mine.next.end(), levels.begin() + static_cast<std::ptrdiff_t>(level_end + offsets[thread_id]));
+                mine.next.clear();
+                merged.arrive_and_wait();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(pool_size - 1);
+        for (int t = 1; t < pool_size; t++) {
+            pool.emplace_back(worker, t);
+        }
+        worker(0);
+        for (auto& thread : pool) {
+            thread.join();
+        }
+
+        // Distances go into the workspace level by level, so its discovery order is a BFS order
+        for (const Local& mine : local) {
+            workspace.count_edges(mine.edges);
+        }
+        workspace.count_expanded(bounds.back());
+        for (std::size_t level = 0; level + 2 < bounds.size(); level++) {
+            workspace.note_depth(bounds[level + 1] - bounds[level]);
+            for (std::size_t i = bounds[level]; i < bounds[level + 1]; i++) {
+                workspace.visit(levels[i], static_cast<int>(level));
+            }
+        }
+    }
+}
+
+void BFSD_par_no_print(const int vertex, const Graph &graph, const Representation representation, TraversalWorkspace &workspace,
+                       const int threads) {
+    const std::size_t words = (static_cast<std::size_t>(graph.n) + WORD_BITS - 1) / WORD_BITS;
+    std::vector<Word>& visited = workspace.bits;
+    visited.assign(words, 0);
+
+    switch (representation) {
+        case Representation::Matrix:
+            // A whole row word is claimed with one atomic operation
+            level_synchronous_bfs(vertex, graph, workspace, threads, visited, [&](const int u, std::vector<int>& next) {
+                const Word* row = graph.adj_matrix.row(u);
+                std::size_t edges = 0;
+                for (std::size_t w = 0; w < words; w++) {
+                    if (row[w] == 0) continue;
+                    edges += static_cast<std::size_t>(std::popcount(row[w]));
+                    for (Word fresh = claim(visited, w, row[w]); fresh != 0; fresh &= fresh - 1) {
+                        next.push_back(static_cast<int>(w * WORD_BITS) + std::countr_zero(fresh));
+                    }
+                }
+                return edges;
+            });
+            break;
+        case Representation::List:
+            level_synchronous_bfs(vertex, graph, workspace, threads, visited, [&](const int u, std::vector<int>& next) {
+                const std::vector<int>& row = graph.adj_list[u];
+                for (const int neigh : row) {
+                    if (claim(visited, neigh)) next.push_back(neigh);
+                }
+                return row.size();
+            });
+            break;
+        case Representation::CSR:
+            level_synchronous_bfs(vertex, graph, workspace, threads, visited, [&](const int u, std::vector<int>& next) {
+                const auto row = graph.adj_csr.row(u);
+                for (const int neigh : row) {
+                    if (claim(visited, neigh)) next.push_back(neigh);
+                }
+                return row.size();
+            });
+            break;
+    }
+}
+
+void BFSD_par(const int vertex, const Graph &graph, const Representation representation, TraversalWorkspace &workspace,
+              const int threads) {
+    BFSD_par_no_print(vertex, graph, representation, workspace, threads);
+
+    TextBuffer out(std::cout);
+    out << "Vertex traversal order: \n";
+    for (const int v : workspace.touched_vertices()) {
+        out << original_id(graph, v) << ' ';
+    }
+    out << '\n';
+}
+
+void BFSD_par_matrix_no_print(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    BFSD_par_no_print(vertex, graph, Representation::Matrix, workspace);
+}
+
+void BFSD_par_list_no_print(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    BFSD_par_no_print(vertex, graph, Representation::List, workspace);
+}
+
+void BFSD_par_csr_no_print(const int vertex, const Graph &graph, TraversalWorkspace &workspace) {
+    BFSD_par_no_print(vertex, graph, Representation::CSR, workspace);
+}
@@ -0,0 +1,183 @@
+#include "../../include/backend/reorder.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <utility>
+
+namespace {
+    // Cuthill-McKee style BFS over every component; roots are tried in the given order
+    std::vector<int> bfs_order(const CSRAdjacency& csr, const std::vector<int>& roots, const bool by_degree) {
+        const int n = csr.size();
+        std::vector<int> order;
+        order.reserve(n);
+        std::vector<char> seen(n, 0);
+        std::vector<int> level;
+
+        for (const int root : roots) {
+            if (seen[root]) continue;
+            seen[root] = 1;
+            order.push_back(root);
+            for (std::size_t head = order.size() - 1; head < order.size(); head++) {
+                level.clear();
+                for (const int neigh : csr.row(order[head])) {
+                    if (!seen[neigh]) {
+                        seen[neigh] = 1;
+                        level.push_back(neigh);
+                    }
+                }
+                if (by_degree) {
+                    std::stable_sort(level.begin(), level.end(),
+                                     [&](const int a, const int b) { return csr.degree(a) < csr.degree(b); });
+                }
+                order.insert(order.end(), level.begin(), level.end());
+            }
+        }
+        return order;
+    }
+
+    std::vector<int> by_degree(const CSRAdjacency& csr, const bool descending) {
+        std::vector<int> vertices(csr.size());
+        std::iota(vertices.begin(), vertices.end(), 0);
+        std::stable_sort(vertices.begin(), vertices.end(), [&](const int a, const int b) {
+            return descending ? csr.degree(a) > csr.degree(b) : csr.degree(a) < csr.degree(b);
+        });
+        return vertices;
+    }
+}
+
+std::vector<int> vertex_ordering(const Graph& graph, const Ordering ordering) {
+    const int n = graph.n;
+    const CSRAdjacency& csr = graph.adj_csr;
+    std::vector<int> order;
+
+    switch (ordering) {
+        case Ordering::RCM:
+            order = bfs_order(csr, by_degree(csr, false), true);
+            std::reverse(order.begin(), order.end());
+            break;
+        case Ordering::BFS: {
+            std::vector<int> roots(n);
+            std::iota(roots.begin(), roots.end(), 0);
+            order = bfs_order(csr, roots, false);
+            break;
+        }
+        case Ordering::Degree:
+            order = by_degree(csr, true);
+            break;
+        case Ordering::None: {
+            std::vector<int> new_id(n);
+            for (int v = 0; v < n; v++) {
+                new_id[v] = original_id(graph, v);
+            }
+            return new_id;
+        }
+    }
+
+    std::vector<int> new_id(n);
+    for (int position = 0; position < n; position++) {
+        new_id[order[position]] = position;
+    }
+    return new_id;
+}
+
+void relabel_graph(Graph& graph, const std::span<const int> new_id) {
+    const int n = graph.n;
+    const CSRAdjacency& csr = graph.adj_csr;
+
+    std::vector<std::int64_t> offsets(static_cast<std::size_t>(n) + 1, 0);
+    for (int v = 0; v < n; v++) {
+        offsets[new_id[v] + 1] = csr.degree(v);
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<int> neighbours(csr.neighbours().size());
+    if (is_weighted(graph)) {
+        // Weights follow their entries, which are re-sorted by the new ids
+        std::vector<std::uint32_t> weights(graph.weights.size());
+        std::vector<std::pair<int, std::uint32_t>> entries;
+        for (int v = 0; v < n; v++) {
+            const auto row = csr.row(v);
+            const std::int64_t first = csr.offsets()[v];
+            entries.clear();
+            for (std::size_t i = 0; i < row.size(); i++) {
+                entries.emplace_back(new_id[row[i]], graph.weights[first + i]);
+            }
+            std::sort(entries.begin(), entries.end());
+            for (std::size_t i = 0; i < entries.size(); i++) {
+                neighbours[offsets[new_id[v]] + i] = entries[i].first;
+                weights[offsets[new_id[v]] + i] = entries[i].second;
+            }
+        }
+        graph.weights = std::move(weights);
+    } else {
+        for (int v = 0; v < n; v++) {
+            const auto first = neighbours.begin() + offsets[new_id[v]];
+            const auto last = std::transform(csr.row(v).begin(), csr.row(v).end(), first,
+                                             [&](const int u) { return new_id[u]; });
+            std::sort(first, last);
+        }
+    }
+    CSRAdjacency relabelled(std::move(offsets), std::move(neighbours));
+
+    if (!graph.adj_matrix.empty()) {
+        // The matrix is refilled from the relabelled rows, so the old one is freed first
+        graph.adj_matrix.reset(n);
+        for (int v = 0; v < n; v++) {
+            for (const int u : relabelled.row(v)) {
+                graph.adj_matrix.set(v, u);
+            }
+        }
+    }
+    if (has_representation(graph, Representation::List)) {
+        for (int v = 0; v < n; v++) {
+            const auto row = relabelled.row(v);
+            graph.adj_list[v].assign(row.begin(), row.end());
+        }
+    }
+    graph.adj_csr = std::move(relabelled);
+
+    std::vector<int> originals(n);
+    bool identity = true;
+    for (int v = 0; v < n; v++) {
+        originals[new_id[v]] = original_id(graph, v);
+    }
+    for (int v = 0; v < n && identity; v++) {
+        identity = originals[v] == v;
+    }
+
+    if (identity) {
+        graph.original_ids.clear();
+        graph.current_ids.clear();
+    } else {
+        graph.current_ids.assign(n, 0);
+        for (int v = 0; v < n; v++) {
+            graph.current_ids[originals[v]] = v;
+        }
+        graph.original_ids = std::move(originals);
+    }
+    graph.version = next_graph_version();
+}
+
+double mean_neighbour_gap(const Graph& graph) {
+    const CSRAdjacency& csr = graph.adj_csr;
+    if (csr.neighbours().empty()) return 0.0;
+    long long total = 0;
+    for (int v = 0; v < graph.n; v++) {
+        for (const int u : csr.row(v)) {
+            total += std::abs(u - v);
+        }
+    }
+    return static_cast<double>(total) / static_cast<double>(csr.neighbours().size());
+}
+
+int graph_bandwidth(const Graph& graph) {
+    int bandwidth = 0;
+    for (int v = 0; v < graph.n; v++) {
+        // Rows are sorted, so the extremes are at the ends
+        if (const auto row = graph.adj_csr.row(v); !row.empty()) {
+            bandwidth = std::max({bandwidth, v - row.front(), row.back() - v});
+        }
+    }
+    return bandwidth;
+}
@@ -0,0 +1,279 @@
+#include "../../include/backend/shortest_paths.h"
+#include "../../include/backend/parallel.h"
+#include "../../include/backend/traversal_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <chrono>
+#include <climits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Tentative distance of vertices no path has reached yet
+    constexpr int UNREACHED = INT_MAX;
+
+    // Frontier vertices taken per counter increment
+    constexpr std::size_t CHUNK = 64;
+
+    // Next bucket of a delta-stepping search once every bucket is empty
+    constexpr std::size_t NO_BUCKET = SIZE_MAX;
+
+    std::uint32_t weight(const Graph& graph, const std::int64_t entry) {
+        return graph.weights.empty() ? 1 : graph.weights[entry];
+    }
+
+    /**
+     * Monotone priority queue of (key, vertex) entries packed into one word. Bucket 0 holds the entries equal
+     * to the last extracted key, bucket i > 0 those whose highest bit differing from it is bit i - 1.
+     * Keys pushed must not be smaller than the last extracted one, which Dijkstra guarantees.
+     */
+    class RadixHeap {
+    public:
+        explicit RadixHeap(std::vector<std::vector<std::uint64_t>>& storage) : buckets(storage) {
+            buckets.resize(KEY_BITS + 1);
+            for (auto& bucket : buckets) bucket.clear();
+        }
+
+        [[nodiscard]] bool empty() const { return count == 0; }
+
+        void push(const std::uint32_t key, const int v) {
+            buckets[bucket_of(key)].push_back(static_cast<std::uint64_t>(key) << 32 | static_cast<std::uint32_t>(v));
+            count++;
+        }
+
+        // Remove an entry with the smallest key; returns its key and sets v
+        std::uint32_t pop(int& v) {
+            if (buckets[0].empty()) {
+                // The smallest key of the lowest non-empty bucket becomes the new reference, which sends
+                // every entry of that bucket to a lower one
+                std::size_t i = 1;
+                while (buckets[i].empty()) i++;
+                std::uint64_t smallest = UINT64_MAX;
+                for (const std::uint64_t entry : buckets[i]) smallest = std::min(smallest, entry);
+                last = static_cast<std::uint32_t>(smallest >> 32);
+                for (const std::uint64_t entry : buckets[i]) {
+                    buckets[bucket_of(static_cast<std::uint32_t>(entry >> 32))].push_back(entry);
+                }
+                buckets[i].clear();
+            }
+            const std::uint64_t entry = buckets[0].back();
+            buckets[0].pop_back();
+            count--;
+            v = static_cast<int>(static_cast<std::uint32_t>(entry));
+            return static_cast<std::uint32_t>(entry >> 32);
+        }
+
+    private:
+        static constexpr int KEY_BITS = 32;
+
+        std::vector<std::vector<std::uint64_t>>& buckets;
+        std::uint32_t last = 0;
+        std::size_t count = 0;
+
+        [[nodiscard]] std::size_t bucket_of(const std::uint32_t key) const { return std::bit_width(key ^ last); }
+    };
+
+    // Lower label to value; true if this call lowered it
+    bool lower(int& label, const int value) {
+        std::atomic_ref<int> target(label);
+        int current = target.load(std::memory_order_relaxed);
+        while (value < current) {
+            if (target.compare_exchange_weak(current, value, std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+
+    // Per-thread buckets of relaxed vertices (bucket b in slot b % ring), on their own cache line
+    struct alignas(64) Local {
+        std::vector<std::vector<int>> buckets;
+        std::size_t edges = 0;
+        std::size_t expanded = 0;
+    };
+
+    int default_delta(const Graph& graph) {
+        const auto entries = static_cast<std::uint64_t>(graph.adj_csr.neighbours().size());
+        if (entries == 0) return 1;
+        const std::uint64_t delta = static_cast<std::uint64_t>(max_edge_weight(graph)) * static_cast<std::uint64_t>(graph.n) / entries;
+        return static_cast<int>(std::clamp<std::uint64_t>(delta, 1, INT_MAX));
+    }
+}
+
+const char* path_engine_name(const PathEngine engine) {
+    switch (engine) {
+        case PathEngine::RadixHeap: return "dijkstra";
+        case PathEngine::DeltaStepping: return "delta";
+    }
+    return "?";
+}
+
+std::uint32_t max_edge_weight(const Graph& graph) {
+    if (graph.weights.empty()) return 1;
+    return *std::max_element(graph.weights.begin(), graph.weights.end());
+}
+
+void check_weighted_range(const Graph& graph) {
+    const auto bound = static_cast<std::uint64_t>(std::max(graph.n - 1, 0)) * max_edge_weight(graph);
+    if (bound >= static_cast<std::uint64_t>(UNREACHED)) {
+        throw std::overflow_error("weighted distances of up to " + std::to_string(bound) + " do not fit the distance buffers");
+    }
+}
+
+void dijkstra(const int vertex, const Graph& graph, TraversalWorkspace& workspace) {
+    const auto offsets = graph.adj_csr.offsets();
+    const auto neighbours = graph.adj_csr.neighbours();
+
+    workspace.begin();
+    std::vector<int>& labels = workspace.labels;
+    labels.assign(graph.n, UNREACHED);
+    RadixHeap heap(workspace.buckets);
+    labels[vertex] = 0;
+    heap.push(0, vertex);
+
+    while (!heap.empty()) {
+        int current = 0;
+        const std::uint32_t distance = heap.pop(current);
+        if (workspace.visited(current)) continue;
+        workspace.settle(current, static_cast<int>(distance));
+        workspace.count_expanded();
+        workspace.count_edges(static_cast<std::size_t>(offsets[current + 1] - offsets[current]));
+
+        for (std::int64_t i = offsets[current]; i < offsets[current + 1]; i++) {
+            const int neigh = neighbours[i];
+            const std::int64_t candidate = static_cast<std::int64_t>(distance) + weight(graph, i);
+            if (candidate < labels[neigh]) {
+                labels[neigh] = static_cast<int>(candidate);
+                heap.push(static_cast<std::uint32_t>(candidate), neigh);
+            }
+        }
+    }
+}
+
+void delta_stepping(const int vertex, const Graph& graph, TraversalWorkspace& workspace, const int delta, const int threads) {
+    const int pool_size = std::clamp(threads > 0 ? threads : hardware_threads(), 1, std::max(graph.n, 1));
+    const std::int64_t width = delta > 0 ? delta : default_delta(graph);
+    // Relaxing bucket b only reaches buckets below b + ring, so the pending ones fit one cycle of slots
+    const auto ring = static_cast<std::size_t>(max_edge_weight(graph) / width + 2);
+    const auto offsets = graph.adj_csr.offsets();
+    const auto neighbours = graph.adj_csr.neighbours();
+
+    workspace.begin();
+    std::vector<int>& labels = workspace.labels;
+    labels.assign(graph.n, UNREACHED);
+    labels[vertex] = 0;
+    std::vector<int>& relaxed_at = workspace.relaxed_at;
+    relaxed_at.assign(graph.n, UNREACHED);
+    std::vector<int>& frontier = workspace.frontier;
+    frontier.assign(1, vertex);
+
+    // Bucket being relaxed and the one after it
+    std::size_t bucket = 0;
+    std::size_t next_bucket = 0;
+    std::vector<Local> local(pool_size);
+    for (Local& mine : local) {
+        mine.buckets.resize(ring);
+    }
+    std::vector<std::size_t> positions(pool_size + 1, 0);
+    std::atomic<std::size_t> cursor{0};
+
+    // Once the frontier is relaxed: the lowest non-empty bucket of any thread is next, each thread's part gets its place
+    auto on_relaxed = [&]() noexcept {
+        next_bucket = NO_BUCKET;
+        for (std::size_t b = bucket; b < bucket + ring && next_bucket == NO_BUCKET; b++) {
+            for (const Local& mine : local) {
+                if (!mine.buckets[b % ring].empty()) next_bucket = b;
+            }
+        }
+        for (int t = 0; t < pool_size; t++) {
+            positions[t + 1] = positions[t] + (next_bucket != NO_BUCKET ? local[t].buckets[next_bucket % ring].size() : 0);
+        }
+        frontier.resize(positions[pool_size]);
+        cursor.store(0, std::memory_order_relaxed);
+    };
+    auto on_merged = [&]() noexcept { bucket = next_bucket; };
+
+    std::barrier relaxed(pool_size, on_relaxed);
+    std::barrier merged(pool_size, on_merged);
+
+    auto worker = [&](const int thread_id) {
+        Local& mine = local[thread_id];
+        for (;;) {
+            if (frontier.empty()) return;
+            const std::size_t size = frontier.size();
+            const std::int64_t bucket_begin = static_cast<std::int64_t>(bucket) * width;
+
+            for (std::size_t first = cursor.fetch_add(CHUNK, std::memory_order_relaxed); first < size;
+                 first = cursor.fetch_add(CHUNK, std::memory_order_relaxed)) {
+                const std::size_t last = std::min(first + CHUNK, size);
+                for (std::size_t f = first; f < last; f++) {
+                    const int current = frontier[f];
+                    const int distance = std::atomic_ref<int>(labels[current]).load(std::memory_order_relaxed);
+                    // Entries of a vertex lowered into an earlier bucket since, or already relaxed from this
+                    // distance by another entry
+                    if (distance < bucket_begin) continue;
+                    if (std::atomic_ref<int>(relaxed_at[current]).exchange(distance, std::memory_order_relaxed) == distance) continue;
+                    mine.expanded++;
+                    mine.edges += static_cast<std::size_t>(offsets[current + 1] - offsets[current]);
+
+                    for (std::int64_t i = offsets[current]; i < offsets[current + 1]; i++) {
+                        const std::int64_t candidate = static_cast<std::int64_t>(distance) + weight(graph, i);
+                        if (lower(labels[neighbours[i]], static_cast<int>(candidate))) {
+                            mine.buckets[static_cast<std::size_t>(candidate / width) % ring].push_back(neighbours[i]);
+                        }
+                    }
+                }
+            }
+            relaxed.arrive_and_wait();
+
+            if (next_bucket != NO_BUCKET) {
+                std::vector<int>& part = mine.buckets[next_bucket % ring];
+                std::copy(part.begin(), part.end(), frontier.begin() + static_cast<std::ptrdiff_t>(positions[thread_id]));
+                part.clear();
+            }
+            merged.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(pool_size - 1);
+    for (int t = 1; t < pool_size; t++) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    for (const Local& mine : local) {
+        workspace.count_expanded(mine.expanded);
+        workspace.count_edges(mine.edges);
+    }
+    for (int v = 0; v < graph.n; v++) {
+        if (labels[v] != UNREACHED) workspace.settle(v, labels[v]);
+    }
+}
+
+void delta_stepping_single(const int vertex, const Graph& graph, TraversalWorkspace& workspace) {
+    delta_stepping(vertex, graph, workspace, 0, 1);
+}
+
+long long time_shortest_paths(const Graph& graph, const int vertex, const PathEngine engine) {
+    TraversalWorkspace workspace(graph.n);
+
+    PerfCounters counters;
+    const auto start = std::chrono::high_resolution_clock::now();
+    if (engine == PathEngine::RadixHeap) {
+        dijkstra(vertex, graph, workspace);
+    } else {
+        delta_stepping(vertex, graph, workspace);
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    counters.stop(workspace.stats);
+    stats_record(path_engine_name(engine), workspace.stats);
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
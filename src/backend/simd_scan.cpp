@@ -0,0 +1,92 @@
+#include "../../include/backend/simd_scan.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    bool row_scan_scalar(const std::uint64_t* row, std::uint64_t* visited, std::uint64_t* fresh, const std::size_t words) {
+        std::uint64_t any = 0;
+        for (std::size_t w = 0; w < words; w++) {
+            const std::uint64_t bits = row[w] & ~visited[w];
+            visited[w] |= bits;
+            fresh[w] = bits;
+            any |= bits;
+        }
+        return any != 0;
+    }
+
+#ifdef SIMD_SCAN_X86
+    __attribute__((target("sse4.2")))
+    bool row_scan_sse42(const std::uint64_t* row, std::uint64_t* visited, std::uint64_t* fresh, const std::size_t words) {
+        __m128i any = _mm_setzero_si128();
+        for (std::size_t w = 0; w < words; w += 2) {
+            const __m128i r = _mm_load_si128(reinterpret_cast<const __m128i*>(row + w));
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(visited + w));
+            const __m128i bits = _mm_andnot_si128(v, r);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(visited + w), _mm_or_si128(v, bits));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(fresh + w), bits);
+            any = _mm_or_si128(any, bits);
+        }
+        return !_mm_testz_si128(any, any);
+    }
+
+    __attribute__((target("avx2")))
+    bool row_scan_avx2(const std::uint64_t* row, std::uint64_t* visited, std::uint64_t* fresh, const std::size_t words) {
+        __m256i any = _mm256_setzero_si256();
+        for (std::size_t w = 0; w < words; w += 4) {
+            const __m256i r = _mm256_load_si256(reinterpret_cast<const __m256i*>(row + w));
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(visited + w));
+            const __m256i bits = _mm256_andnot_si256(v, r);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(visited + w), _mm256_or_si256(v, bits));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(fresh + w), bits);
+            any = _mm256_or_si256(any, bits);
+        }
+        return !_mm256_testz_si256(any, any);
+    }
+
+    __attribute__((target("avx512f")))
+    bool row_scan_avx512(const std::uint64_t* row, std::uint64_t* visited, std::uint64_t* fresh, const std::size_t words) {
+        __m512i any = _mm512_setzero_si512();
+        for (std::size_t w = 0; w < words; w += 8) {
+            const __m512i r = _mm512_load_si512(row + w);
+            const __m512i v = _mm512_loadu_si512(visited + w);
+            const __m512i bits = _mm512_maskz_andnot_epi64(0xFF, v, r);
+            _mm512_storeu_si512(visited + w, _mm512_or_si512(v, bits));
+            _mm512_storeu_si512(fresh + w, bits);
+            any = _mm512_or_si512(any, bits);
+        }
+        return _mm512_test_epi64_mask(any, any) != 0;
+    }
+#endif
+
+    struct ScanKernel {
+        RowScanFn fn;
+        const char* isa;
+    };
+
+    ScanKernel resolve_row_scan() {
+#ifdef SIMD_SCAN_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return {row_scan_avx512, "AVX-512"};
+        if (__builtin_cpu_supports("avx2")) return {row_scan_avx2, "AVX2"};
+        if (__builtin_cpu_supports("sse4.2")) return {row_scan_sse42, "SSE4.2"};
+#endif
+        return {row_scan_scalar, "scalar"};
+    }
+
+    const ScanKernel selected = resolve_row_scan();
+}
+
+RowScanFn row_scan = selected.fn;
+
+const char* row_scan_isa() {
+    return selected.isa;
+}
+
+RowScanner::RowScanner(const BitMatrix& adjacency, TraversalWorkspace& workspace)
+    : matrix(adjacency), words(adjacency.words_per_row()), visited(workspace.bits), fresh(workspace.fresh_bits) {
+    visited.assign(words, 0);
+    fresh.resize(words);
+}
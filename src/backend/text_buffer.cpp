@@ -0,0 +1,60 @@
+#include "../../include/backend/text_buffer.h"
+
+#include <algorithm>
+
+TextBuffer::TextBuffer(std::ostream& stream, const std::size_t capacity)
+    : out(stream), data(std::max(capacity, max_number_chars)) {}
+
+TextBuffer::~TextBuffer() {
+    flush();
+}
+
+TextBuffer& TextBuffer::operator<<(const std::string_view text) {
+    if (text.size() > data.size()) {
+        drain();
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        return *this;
+    }
+    reserve(text.size());
+    std::copy(text.begin(), text.end(), data.begin() + static_cast<std::ptrdiff_t>(used));
+    used += text.size();
+    return *this;
+}
+
+TextBuffer& TextBuffer::operator<<(const double value) {
+    reserve(max_number_chars);
+    used = static_cast<std::size_t>(
+        std::to_chars(data.data() + used, data.data() + data.size(), value, std::chars_format::general, 6).ptr - data.data());
+    return *this;
+}
+
+TextBuffer& TextBuffer::repeat(const char c, std::size_t count) {
+    while (count > 0) {
+        if (used == data.size()) drain();
+        const std::size_t chunk = std::min(count, data.size() - used);
+        std::fill_n(data.begin() + static_cast<std::ptrdiff_t>(used), chunk, c);
+        used += chunk;
+        count -= chunk;
+    }
+    return *this;
+}
+
+void TextBuffer::flush() {
+    drain();
+    out.flush();
+}
+
+int TextBuffer::width_of(long long value) {
+    int width = value < 0 ? 2 : 1;
+    while (value <= -10 || value >= 10) {
+        value /= 10;
+        width++;
+    }
+    return width;
+}
+
+void TextBuffer::drain() {
+    if (used == 0) return;
+    out.write(data.data(), static_cast<std::streamsize>(used));
+    used = 0;
+}
@@ -0,0 +1,159 @@
+#include "../../include/backend/traversal_stats.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+#include <utility>
+
+#if defined(__linux__) && defined(TRAVERSAL_PERF_COUNTERS)
+#include <cstdint>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define HAVE_PERF_EVENTS
+#endif
+
+void TraversalStats::merge(const TraversalStats& other) {
+    searches += other.searches;
+    dequeued += other.dequeued;
+    edges_examined += other.edges_examined;
+    discoveries += other.discoveries;
+    peak_depth = std::max(peak_depth, other.peak_depth);
+    if (level_sizes.size() < other.level_sizes.size()) level_sizes.resize(other.level_sizes.size(), 0);
+    for (std::size_t level = 0; level < other.level_sizes.size(); level++) {
+        level_sizes[level] += other.level_sizes[level];
+    }
+    if (other.cycles >= 0) cycles = std::max(cycles, 0LL) + other.cycles;
+    if (other.llc_misses >= 0) llc_misses = std::max(llc_misses, 0LL) + other.llc_misses;
+}
+
+#ifdef HAVE_PERF_EVENTS
+namespace {
+    int open_counter(const std::uint64_t config, const int group_fd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = group_fd == -1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+    }
+
+    long long read_counter(const int fd) {
+        long long value = 0;
+        return fd >= 0 && read(fd, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value)) ? value : -1;
+    }
+}
+
+PerfCounters::PerfCounters() {
+    // Cycles lead the group, so both counters run over exactly the same interval
+    cycles_fd = open_counter(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (cycles_fd < 0) return;
+    misses_fd = open_counter(PERF_COUNT_HW_CACHE_MISSES, cycles_fd);
+    ioctl(cycles_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(cycles_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounters::~PerfCounters() {
+    if (misses_fd >= 0) close(misses_fd);
+    if (cycles_fd >= 0) close(cycles_fd);
+}
+
+void PerfCounters::stop(TraversalStats& stats) {
+    if (cycles_fd < 0) return;
+    ioctl(cycles_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    stats.cycles = read_counter(cycles_fd);
+    stats.llc_misses = read_counter(misses_fd);
+}
+#else
+PerfCounters::PerfCounters() = default;
+PerfCounters::~PerfCounters() = default;
+void PerfCounters::stop(TraversalStats&) {}
+#endif
+
+namespace {
+    // Report of the foreground commands; jobs started without a StatsScope may still record concurrently
+    std::mutex report_mutex;
+    StatsReport report;
+
+    // Report of the StatsScope active on this thread, if any
+    thread_local StatsReport* scoped_report = nullptr;
+
+    void print_counter(std::ostream& out, const char* name, const long long value) {
+        out << "  " << std::left << std::setw(18) << name << std::right;
+        if (value < 0) {
+            out << "unavailable" << std::endl;
+        } else {
+            out << value << std::endl;
+        }
+    }
+
+    void print_report(std::ostream& out, const StatsReport& recorded) {
+        out << "Stats for " << recorded.title << ":" << std::endl;
+        for (const auto& [method, stats] : recorded.runs) {
+            out << method << ":" << std::endl;
+            print_counter(out, "searches", stats.searches);
+            print_counter(out, "dequeued", stats.dequeued);
+            print_counter(out, "edges examined", stats.edges_examined);
+            print_counter(out, "discoveries", stats.discoveries);
+            print_counter(out, "peak depth", static_cast<long long>(stats.peak_depth));
+            print_counter(out, "cycles", stats.cycles);
+            print_counter(out, "LLC misses", stats.llc_misses);
+
+            out << "  level sizes:      ";
+            for (const long long size : stats.level_sizes) {
+                out << size << " ";
+            }
+            out << std::endl;
+        }
+    }
+}
+
+StatsScope::StatsScope() : outer(scoped_report) {
+    scoped_report = &report;
+}
+
+StatsScope::~StatsScope() {
+    scoped_report = outer;
+}
+
+void StatsScope::print(std::ostream& out) const {
+    if (traversal_stats_enabled && !report.runs.empty()) print_report(out, report);
+}
+
+void stats_begin(const std::string& title) {
+    if (scoped_report != nullptr) {
+        *scoped_report = {title, {}};
+        return;
+    }
+    std::lock_guard lock(report_mutex);
+    report.title = title;
+    report.runs.clear();
+}
+
+void stats_record(const std::string& method, const TraversalStats& stats) {
+    if (scoped_report != nullptr) {
+        scoped_report->runs.emplace_back(method, stats);
+        return;
+    }
+    std::lock_guard lock(report_mutex);
+    report.runs.emplace_back(method, stats);
+}
+
+void print_stats(std::ostream& out) {
+    if (!traversal_stats_enabled) {
+        out << "Traversal counters are not compiled in, rebuild with -DENABLE_TRAVERSAL_STATS=ON" << std::endl;
+        return;
+    }
+
+    std::lock_guard lock(report_mutex);
+    if (report.runs.empty()) {
+        out << "No traversal recorded yet, run 'traversal' or 'compare' first" << std::endl;
+        return;
+    }
+    print_report(out, report);
+}
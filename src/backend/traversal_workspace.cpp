@@ -0,0 +1,52 @@
+#include "../../include/backend/traversal_workspace.h"
+
+#include <algorithm>
+#include <bit>
+
+TraversalWorkspace::TraversalWorkspace(const int vertices) {
+    prepare(vertices);
+}
+
+void TraversalWorkspace::prepare(const int vertices) {
+    if (vertices <= n) return;
+
+    n = vertices;
+    const auto count = static_cast<std::size_t>(vertices);
+    // Every vertex is enqueued at most once per search, so a power-of-two ring of n slots never overflows
+    const std::size_t capacity = std::bit_ceil(count);
+    mask = capacity - 1;
+
+    stamp.assign(count, 0);
+    generation = 1;
+    dist.resize(count);
+    order.resize(count);
+    queue.resize(capacity);
+    stack.resize(count);
+    frontier.reserve(count);
+    next_frontier.reserve(count);
+    touched = head = tail = top = 0;
+}
+
+void TraversalWorkspace::begin() {
+    if constexpr (traversal_stats_enabled) stats.searches++;
+    if (++generation == 0) {
+        // Stamps wrapped around: clear them once every 2^32 searches
+        std::fill(stamp.begin(), stamp.end(), 0);
+        generation = 1;
+    }
+    touched = 0;
+    head = tail = 0;
+    top = 0;
+}
+
+void TraversalWorkspace::export_distances(const std::span<int> out) const {
+    for (std::size_t i = 0; i < touched; i++) {
+        out[order[i]] = dist[order[i]];
+    }
+}
+
+void TraversalWorkspace::export_all(const std::span<int> out) const {
+    for (std::size_t v = 0; v < out.size(); v++) {
+        out[v] = distance(static_cast<int>(v));
+    }
+}
@@ -0,0 +1,18 @@
+#include "../include/backend/bench.h"
+
+#include <cstdlib>
+
+int main(const int argc, char** argv) {
+    try {
+        const BenchOptions options = parse_bench_options(std::vector<std::string>(argv + 1, argv + argc));
+        if (options.use_current) {
+            std::cerr << "--current needs the interactive console" << std::endl;
+            return EXIT_FAILURE;
+        }
+        report_bench(run_bench(options), options);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
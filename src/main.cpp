@@ -1,8 +1,51 @@
 #include "../include/adapters/console_adapter.h"
 
-int main() {
+#include <fstream>
+#include <sstream>
+
+namespace {
+    // Exit code for bad command line arguments or an unreadable script
+    constexpr int EXIT_USAGE = 2;
+
+    void print_usage(const char* program) {
+        std::cerr << "Usage: " << program << " [--script <file>] [--exec \"<command>; <command>...\"]" << std::endl;
+    }
+}
+
+int main(const int argc, char* argv[]) {
     try {
+        // Batch commands from --script files and --exec lists, in command line order
+        std::stringstream batch;
+        bool batch_mode = false;
+
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+            if (i + 1 >= argc || (arg != "--script" && arg != "--exec")) {
+                print_usage(argv[0]);
+                return EXIT_USAGE;
+            }
+
+            const std::string value = argv[++i];
+            if (arg == "--script") {
+                std::ifstream script(value);
+                if (!script) {
+                    std::cerr << "Error: cannot open script " << value << std::endl;
+                    return EXIT_USAGE;
+                }
+                // Streaming an empty file would set failbit on batch
+                if (script.peek() != std::ifstream::traits_type::eof()) batch << script.rdbuf();
+                batch << '\n';
+            } else {
+                for (const char c : value) batch << (c == ';' ? '\n' : c);
+                batch << '\n';
+            }
+            batch_mode = true;
+        }
+
         GraphConsoleAdapter console;
+        if (batch_mode) {
+            return console.run_batch(batch) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
         console.run();
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
@@ -12,4 +55,4 @@ int main() {
         return EXIT_FAILURE;
     }
     return 0;
-}
\ No newline at end of file
+}
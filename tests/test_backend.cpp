@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "backend/dynamic_distances.h"
+#include "backend/generators.h"
+#include "backend/graph_gen.h"
+#include "backend/graph_io.h"
+#include "backend/shortest_paths.h"
+#include "backend/traversal_workspace.h"
+
+namespace {
+    // Erdős–Rényi graph without the matrix, weights in [1, max_weight] (0 - unweighted)
+    Graph random_graph(const int n, const double edge_prob, const std::uint32_t max_weight, const unsigned int seed) {
+        GeneratorOptions options;
+        options.n = n;
+        options.edge_prob = edge_prob;
+        options.loop_prob = 0.05;
+        options.max_weight = max_weight;
+        options.seed = seed;
+        return generate_graph(options);
+    }
+
+    // Distances left in the workspace by a search from source
+    std::vector<int> run(const std::function<void(TraversalWorkspace&)>& search, const Graph& graph) {
+        TraversalWorkspace workspace(graph.n);
+        search(workspace);
+        std::vector<int> distances(graph.n);
+        workspace.export_all(distances);
+        return distances;
+    }
+
+    std::vector<int> bfs_distances(const Graph& graph, const int source) {
+        return run([&](TraversalWorkspace& workspace) { BFSD_csr_no_print(source, graph, workspace); }, graph);
+    }
+
+    // Reference: binary heap Dijkstra over the CSR arrays
+    std::vector<int> heap_dijkstra(const Graph& graph, const int source) {
+        constexpr long long unreached = std::numeric_limits<long long>::max();
+        const auto offsets = graph.adj_csr.offsets();
+        const auto neighbours = graph.adj_csr.neighbours();
+        std::vector<long long> dist(graph.n, unreached);
+        std::priority_queue<std::pair<long long, int>, std::vector<std::pair<long long, int>>, std::greater<>> heap;
+        dist[source] = 0;
+        heap.emplace(0, source);
+        while (!heap.empty()) {
+            const auto [d, u] = heap.top();
+            heap.pop();
+            if (d > dist[u]) continue;
+            for (auto i = offsets[u]; i < offsets[u + 1]; i++) {
+                const long long weight = is_weighted(graph) ? graph.weights[i] : 1;
+                if (const int v = neighbours[i]; d + weight < dist[v]) {
+                    dist[v] = d + weight;
+                    heap.emplace(dist[v], v);
+                }
+            }
+        }
+
+        std::vector<int> distances(graph.n);
+        for (int v = 0; v < graph.n; v++) distances[v] = dist[v] == unreached ? -1 : static_cast<int>(dist[v]);
+        return distances;
+    }
+
+    // Every engine configuration checked against the expected distances from source
+    void expect_engines(const Graph& graph, const int source, const std::vector<int>& expected) {
+        EXPECT_EQ(run([&](TraversalWorkspace& workspace) { dijkstra(source, graph, workspace); }, graph), expected);
+        for (const int threads : {1, 2, 4}) {
+            for (const int delta : {0, 1, 7}) {
+                SCOPED_TRACE("threads " + std::to_string(threads) + ", delta " + std::to_string(delta));
+                EXPECT_EQ(run([&](TraversalWorkspace& workspace) {
+                    delta_stepping(source, graph, workspace, delta, threads);
+                }, graph), expected);
+            }
+        }
+    }
+}
+
+TEST(ShortestPaths, UnweightedMatchesBFS) {
+    for (const unsigned int seed : {1u, 2u, 3u}) {
+        const Graph graph = random_graph(400, 0.01, 0, seed);
+        for (const int source : {0, 17, 399}) {
+            SCOPED_TRACE("seed " + std::to_string(seed) + ", source " + std::to_string(source));
+            expect_engines(graph, source, bfs_distances(graph, source));
+        }
+    }
+}
+
+TEST(ShortestPaths, UnitWeightsMatchBFS) {
+    Graph graph = random_graph(300, 0.02, 0, 4);
+    assign_random_weights(graph, 1, 4);
+    ASSERT_TRUE(is_weighted(graph));
+    expect_engines(graph, 5, bfs_distances(graph, 5));
+}
+
+TEST(ShortestPaths, WeightedMatchesHeapDijkstra) {
+    for (const std::uint32_t max_weight : {2u, 50u, 100000u}) {
+        for (const unsigned int seed : {5u, 6u}) {
+            const Graph graph = random_graph(500, 0.012, max_weight, seed);
+            check_weighted_range(graph);
+            for (const int source : {0, 250}) {
+                SCOPED_TRACE("max weight " + std::to_string(max_weight) + ", seed " + std::to_string(seed)
+                             + ", source " + std::to_string(source));
+                expect_engines(graph, source, heap_dijkstra(graph, source));
+            }
+        }
+    }
+}
+
+TEST(GraphIO, RejectsZeroWeights) {
+    const Graph graph = random_graph(50, 0.2, 9, 7);
+    const std::string path = (std::filesystem::temp_directory_path() / "lab9_zero_weight.bin").string();
+    save_graph(graph, path);
+
+    // Header field weights_pos is the uint64 at byte 80
+    std::uint64_t weights_pos = 0;
+    {
+        std::ifstream in(path, std::ios::binary);
+        in.seekg(80);
+        in.read(reinterpret_cast<char*>(&weights_pos), sizeof(weights_pos));
+    }
+    ASSERT_NE(weights_pos, 0u);
+    {
+        std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+        constexpr std::uint32_t zero = 0;
+        out.seekp(static_cast<std::streamoff>(weights_pos));
+        out.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
+    }
+
+    try {
+        load_graph(path);
+        ADD_FAILURE() << "a zero weight was accepted";
+    } catch (const std::runtime_error& error) {
+        EXPECT_NE(std::string(error.what()).find("non-positive edge weights"), std::string::npos) << error.what();
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(DynamicDistances, RepairMatchesFreshBFS) {
+    for (const unsigned int seed : {8u, 9u}) {
+        Graph graph = random_graph(200, 0.012, 0, seed);
+        DynamicDistances distances;
+        for (const int source : {0, 1, 57, 199}) distances.track(source, bfs_distances(graph, source));
+
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<int> vertex(0, graph.n - 1);
+        for (int step = 0; step < 400; step++) {
+            const int u = vertex(random);
+            const auto row = graph.adj_csr.row(u);
+            // Removals and insertions alternate roughly evenly, so paths keep appearing and breaking
+            if (random() % 2 == 0 && !row.empty()) {
+                const int v = row[random() % row.size()];
+                ASSERT_TRUE(remove_edge(graph, u, v));
+                distances.edge_removed(graph, u, v);
+            } else if (const int v = vertex(random); add_edge(graph, u, v)) {
+                distances.edge_added(graph, u, v);
+            }
+
+            for (const int source : distances.tracked_sources()) {
+                SCOPED_TRACE("seed " + std::to_string(seed) + ", step " + std::to_string(step)
+                             + ", source " + std::to_string(source));
+                ASSERT_EQ(*distances.find(source), bfs_distances(graph, source));
+            }
+        }
+    }
+}